@@ -23,11 +23,20 @@ Agnus::Agnus(Amiga& ref) : AmigaComponent(ref)
     
     config.revision = AGNUS_ECS_1MB;
     ptrMask = 0x0FFFFF;
+
+    #ifdef FORCE_AGNUS_REVISION
+    config.revision = FORCE_AGNUS_REVISION;
+    ptrMask = isOCS() ? 0x07FFFF : config.revision == AGNUS_ECS_1MB ? 0x0FFFFF : 0x1FFFFF;
+    #endif
     
     initLookupTables();
     
     // Wipe out the event slots
     memset(slot, 0, sizeof(slot));
+    
+    // Empty the bitplane table cache
+    memset(bplCache, 0, sizeof(bplCache));
+    rebuildTriggerTree();
 }
 
 void Agnus::_reset(bool hard)
@@ -52,6 +61,7 @@ void Agnus::_reset(bool hard)
         slot[i].id = (EventID)0;
         slot[i].data = 0;
     }
+    rebuildTriggerTree();
     
     // Schedule initial events
     scheduleRel<SLOT_RAS>(DMA_CYCLES(HPOS_CNT), RAS_HSYNC);
@@ -165,6 +175,14 @@ Agnus::slowRamIsMirroredIn()
     }
 }
 
+isize
+Agnus::didLoadFromBuffer(const u8 *buffer)
+{
+    // The trigger tree is not part of the snapshot
+    rebuildTriggerTree();
+    return 0;
+}
+
 void
 Agnus::_inspect()
 {
@@ -271,6 +289,39 @@ Agnus::_dump(Dump::Category category, std::ostream& os) const
         os << HEX32 << dskpt << std::endl;
     }
     
+    if (category & Dump::Dma) {
+
+        auto &bus = stats.lastFrame;
+        auto slots = bus.slots ? bus.slots : 1;
+        auto sum = [&](BusOwner first, BusOwner last) {
+            long result = 0;
+            for (isize i = first; i <= last; i++) result += bus.usage[i];
+            return result;
+        };
+        auto print = [&](const char *name, long value) {
+            os << DUMP(name) << DEC << std::setw(6) << value;
+            os << "  (" << std::fixed << std::setprecision(1);
+            os << std::setw(5) << 100.0 * value / slots << " %)" << std::endl;
+        };
+
+        long used = sum(BUS_CPU, BUS_BLITTER);
+
+        os << DUMP("Frame") << DEC << bus.frame << std::endl;
+        os << DUMP("DMA slots") << DEC << bus.slots << std::endl;
+        print("CPU", bus.usage[BUS_CPU]);
+        print("Refresh", bus.usage[BUS_REFRESH]);
+        print("Disk", bus.usage[BUS_DISK]);
+        print("Audio", bus.usage[BUS_AUDIO]);
+        print("Bitplanes", sum(BUS_BPL1, BUS_BPL6));
+        print("Sprites", sum(BUS_SPRITE0, BUS_SPRITE7));
+        print("Copper", bus.usage[BUS_COPPER]);
+        print("Blitter", bus.usage[BUS_BLITTER]);
+        print("Unused", bus.slots - used);
+        os << DUMP("CPU wait states") << DEC << bus.cpuWaitStates;
+        os << " DMA cycles in " << bus.cpuWaits << " accesses" << std::endl;
+        os << DUMP("Blitter slowdowns") << DEC << bus.blitterSlowdowns << std::endl;
+    }
+
     if (category & Dump::Events) {
         
         EventInfo eventInfo;
@@ -328,7 +379,11 @@ void
 Agnus::clearStats()
 {
     for (isize i = 0; i < BUS_COUNT; i++) stats.usage[i] = 0;
-    
+    stats.cpuWaits = 0;
+    stats.cpuWaitStates = 0;
+    stats.blitterSlowdowns = 0;
+    memset(&stats.lastFrame, 0, sizeof(stats.lastFrame));
+
     stats.copperActivity = 0;
     stats.blitterActivity = 0;
     stats.diskActivity = 0;
@@ -371,8 +426,20 @@ Agnus::updateStats()
     stats.audioActivity = w * stats.audioActivity + (1 - w) * audio;
     stats.spriteActivity = w * stats.spriteActivity + (1 - w) * sprite;
     stats.bitplaneActivity = w * stats.bitplaneActivity + (1 - w) * bitplane;
-    
+
+    // Record the bus statistics of the finished frame
+    auto &last = stats.lastFrame;
+    last.frame = frame.nr - 1;
+    last.slots = frame.prevNumLines() * HPOS_CNT;
+    for (isize i = 0; i < BUS_COUNT; i++) last.usage[i] = stats.usage[i];
+    last.cpuWaits = stats.cpuWaits;
+    last.cpuWaitStates = stats.cpuWaitStates;
+    last.blitterSlowdowns = stats.blitterSlowdowns;
+
     for (isize i = 0; i < BUS_COUNT; i++) stats.usage[i] = 0;
+    stats.cpuWaits = 0;
+    stats.cpuWaitStates = 0;
+    stats.blitterSlowdowns = 0;
 }
 
 Cycle
@@ -679,7 +746,7 @@ void
 Agnus::execute()
 {
     // Process pending events
-    if (nextTrigger <= clock) {
+    if (triggerTree[1] <= clock) {
         executeEventsUntil(clock);
     } else {
         assert(pos.h < 0xE2);
@@ -719,22 +786,36 @@ Agnus::executeUntil(Cycle targetClock)
     // Align to DMA cycle raster
     targetClock &= ~0b111;
 
-    // Compute the number of DMA cycles to execute
-    DMACycle dmaCycles = (targetClock - clock) / DMA_CYCLES(1);
+    /* Instead of emulating DMA cycles one after another, we jump from one
+     * trigger cycle to the next. Nothing happens in between except for the
+     * beam moving forward. Hence, lines that only contain bitplane or
+     * sprite fetches are processed in a tight loop, whereas register
+     * changes, Copper, or Blitter events are served as they come up.
+     */
+    while (clock < targetClock) {
 
-    if (targetClock < nextTrigger && dmaCycles > 0) {
+        // Process pending events
+        if (triggerTree[1] <= clock) executeEventsUntil(clock);
 
-        // Advance directly to the target clock
-        clock = targetClock;
-        pos.h += dmaCycles;
+        // Determine the number of DMA cycles to skip
+        DMACycle cycles = 1;
+        if (triggerTree[1] > clock + DMA_CYCLES(1)) {
 
-        // If this assertion hits, the HSYNC event hasn't been served
-        assert(pos.h <= HPOS_CNT);
+            Cycle next = std::min(triggerTree[1], targetClock);
+            cycles = AS_DMA_CYCLES(next - clock + DMA_CYCLES(1) - 1);
+        }
+        
+        // Advance the internal clock and the horizontal counter
+        clock += DMA_CYCLES(cycles);
 
-    } else {
+        if (cycles == 1) {
+            pos.h = pos.h < HPOS_MAX ? pos.h + 1 : 0;
+        } else {
+            pos.h += cycles;
+        }
 
-        // Execute DMA cycles one after another
-        for (DMACycle i = 0; i < dmaCycles; i++) execute();
+        // If this assertion hits, the HSYNC event hasn't been served
+        assert(pos.h <= HPOS_CNT);
     }
 }
 #endif
@@ -798,35 +879,37 @@ Agnus::inSyncWithEClock()
 */
 
 void
-Agnus::executeUntilBusIsFree()
-{    
-    i16 posh = pos.h == 0 ? HPOS_MAX : pos.h - 1;
-
-    // Check if the bus is blocked
-    if (busOwner[posh] != BUS_NONE) {
+Agnus::waitForBus(i16 posh)
+{
+    assert(busOwner[posh] != BUS_NONE);
+    
+    // This variable counts the number of DMA cycles the CPU will be suspended
+    DMACycle delay = 0;
 
-        // This variable counts the number of DMA cycles the CPU will be suspended
-        DMACycle delay = 0;
+    // Execute Agnus until the bus is free
+    do {
+        // debug("Blocked by %d\n", busOwner[posh]);
 
-        // Execute Agnus until the bus is free
-        do {
-            // debug("Blocked by %d\n", busOwner[posh]);
+        // Fast-forward through bitplane DMA (the BLS line is already set)
+        if (delay >= 2) delay += skipBplFetchCycles();
 
-            posh = pos.h;
-            execute();
-            if (++delay == 2) bls = true;
-            
-        } while (busOwner[posh] != BUS_NONE);
+        posh = pos.h;
+        execute();
+        if (++delay == 2) bls = true;
+        
+    } while (busOwner[posh] != BUS_NONE);
 
-        // Clear the BLS line (Blitter slow down)
-        bls = false;
+    // Clear the BLS line (Blitter slow down)
+    bls = false;
 
-        // Add wait states to the CPU
-        cpu.addWaitStates(DMA_CYCLES(delay));
-    }
+    // Add wait states to the CPU
+    cpu.addWaitStates(DMA_CYCLES(delay));
+    stats.cpuWaits++;
+    stats.cpuWaitStates += delay;
 
     // Assign bus to the CPU
     busOwner[posh] = BUS_CPU;
+    stats.usage[BUS_CPU]++;
 }
 
 void
@@ -846,6 +929,9 @@ Agnus::executeUntilBusIsFreeForCIA()
         // Execute Agnus until the bus is free
         do {
 
+            // Fast-forward through bitplane DMA (the BLS line is already set)
+            if (delay >= 2) delay += skipBplFetchCycles();
+
             posh = pos.h;
             execute();
             if (++delay == 2) bls = true;
@@ -857,10 +943,36 @@ Agnus::executeUntilBusIsFreeForCIA()
 
         // Add wait states to the CPU
         cpu.addWaitStates(DMA_CYCLES(delay));
+        stats.cpuWaits++;
+        stats.cpuWaitStates += delay;
     }
 
     // Assign bus to the CPU
     busOwner[posh] = BUS_CPU;
+    stats.usage[BUS_CPU]++;
+}
+
+DMACycle
+Agnus::skipBplFetchCycles()
+{
+    // Number of upcoming cycles occupied by bitplane fetches
+    DMACycle cycles = nextCpuSlot[pos.h] - pos.h;
+    
+    /* A register change may rewrite the bitplane event table. Hence, we only
+     * trust the table up to the next pending register change.
+     */
+    Cycle regTrigger = slot[SLOT_REG].triggerCycle;
+    if (regTrigger < clock + DMA_CYCLES(cycles)) {
+        cycles = regTrigger > clock ? AS_DMA_CYCLES(regTrigger - clock) : 0;
+    }
+    
+    /* All cycles in this range are bitplane fetches which must be executed
+     * cycle by cycle. However, it is known in advance that the bus is blocked
+     * in all of them which makes checking the bus owner superfluous.
+     */
+    for (DMACycle i = 0; i < cycles; i++) execute();
+    
+    return cycles;
 }
 
 void
@@ -891,7 +1003,7 @@ Agnus::executeFirstSpriteCycle()
 
             // Read in the next control word (POS part)
             u16 value = doSpriteDMA<nr>();
-            agnus.pokeSPRxPOS<nr>(value);
+            agnus.pokeSPRxPOS<nr, ACCESSOR_AGNUS>(value);
             denise.pokeSPRxPOS<nr>(value);
         }
 
@@ -919,7 +1031,7 @@ Agnus::executeSecondSpriteCycle()
             
             // Read in the next control word (CTL part)
             u16 value = doSpriteDMA<nr>();
-            agnus.pokeSPRxCTL<nr>(value);
+            agnus.pokeSPRxCTL<nr, ACCESSOR_AGNUS>(value);
             denise.pokeSPRxCTL<nr>(value);
         }
 
@@ -965,6 +1077,9 @@ Agnus::hsyncHandler()
 {
     assert(pos.h == 0 || pos.h == HPOS_MAX + 1);
 
+    // Record the bus usage tables if requested
+    if (timeline.isRunning()) timeline.recordLine(frame.nr, pos.v, busOwner, busValue);
+
     // Call the hsync handlers of Denise
     denise.endOfLine(pos.v);
 
@@ -1050,8 +1165,20 @@ Agnus::hsyncHandler()
         newDmaDAS = 0;
     }
 
-    if (dmaDAS != newDmaDAS) hsyncActions |= HSYNC_UPDATE_DAS_TABLE;
+    // Determine the sprites that perform DMA in the line to come
+    u8 newDmaSPR = 0;
+
+    if (newDmaDAS & SPREN) {
+        for (isize i = 0; i < 8; i++) {
+            if (sprDmaState[i] == SPR_DMA_ACTIVE || sprVStop[i] == pos.v) {
+                SET_BIT(newDmaSPR, i);
+            }
+        }
+    }
+
+    if (dmaDAS != newDmaDAS || dmaSPR != newDmaSPR) hsyncActions |= HSYNC_UPDATE_DAS_TABLE;
     dmaDAS = newDmaDAS;
+    dmaSPR = newDmaSPR;
 
     //
     // Process pending work items
@@ -1069,7 +1196,7 @@ Agnus::hsyncHandler()
         }
         if (hsyncActions & HSYNC_UPDATE_DAS_TABLE) {
             hsyncActions &= ~HSYNC_UPDATE_DAS_TABLE;
-            updateDasEvents(dmaDAS);
+            updateDasEvents(dmaDAS, dmaSPR);
         }
     }
 
@@ -12,6 +12,7 @@
 #include "AgnusTypes.h"
 #include "AmigaComponent.h"
 #include "Beam.h"
+#include "BusTimeline.h"
 #include "Blitter.h"
 #include "ChangeRecorder.h"
 #include "Copper.h"
@@ -59,6 +60,13 @@ class Agnus : public AmigaComponent {
     // Current workload
     AgnusStats stats;
 
+public:
+
+    // Recorder for the bus usage tables
+    BusTimeline timeline;
+
+private:
+
 
     //
     // Sub components
@@ -82,8 +90,15 @@ public:
     
 private:
     
-    // Next trigger cycle
-    Cycle nextTrigger = NEVER;
+    /* Tournament tree over the trigger cycles of all event slots. The leaves
+     * store the trigger cycles in the order in which the slots are served.
+     * Each inner node stores the minimum of its two children. Hence, the
+     * root (index 1) holds the next trigger cycle, and all due slots can be
+     * located without visiting the others.
+     * See also: executeEventsUntil()
+     */
+    static constexpr isize treeLeaves = 32;
+    Cycle triggerTree[2 * treeLeaves];
     
 
     //
@@ -101,6 +116,42 @@ private:
     // Jump tables connecting the scheduled events
     u8 nextBplEvent[HPOS_CNT];
     u8 nextDasEvent[HPOS_CNT];
+
+    /* For each DMA cycle, the first cycle at or after this position which is
+     * not occupied by a bitplane fetch. Used to fast-forward the CPU through
+     * bitplane DMA it has to wait for.
+     * See also: executeUntilBusIsFree()
+     */
+    u8 nextCpuSlot[HPOS_CNT];
+
+    /* Cache of recently built bitplane event tables. At the beginning of
+     * each line, the bitplane event table is rebuilt from scratch. Because
+     * the result only depends on a few parameters and most lines repeat one
+     * of a few display modes, the tables are cached and replaced in LRU
+     * order. An entry with a stamp of 0 is empty.
+     * See also: updateBplEvents()
+     */
+    struct BplTableKey {
+        
+        i16 hires, channels;
+        i16 strtOdd, strtEven, stopOdd, stopEven;
+        i16 scrollOdd, scrollEven;
+        
+        bool operator==(const BplTableKey& other) const {
+            return memcmp(this, &other, sizeof(BplTableKey)) == 0;
+        }
+    };
+    struct BplTableEntry {
+        
+        BplTableKey key;
+        u64 stamp;
+        EventID bplEvent[HPOS_CNT];
+        u8 nextBplEvent[HPOS_CNT];
+        u8 nextCpuSlot[HPOS_CNT];
+    };
+    static constexpr isize bplCacheSize = 8;
+    BplTableEntry bplCache[bplCacheSize];
+    u64 bplCacheStamp = 0;
     
 
     //
@@ -182,6 +233,13 @@ public:
      */
     u16 dmaDAS;
 
+    /* Indicates which sprites perform DMA in the current rasterline. The value
+     * is computed in the hsync handler. Only the sprites with a set bit have
+     * their slots in the DAS event table. All other sprites are idle in this
+     * line and their DMA cycles would have no effect.
+     */
+    u8 dmaSPR;
+
     /* Horizontal shift values derived from BPLCON1. All four values are
      * extracted in setBPLCON1() and utilized to emulate horizontal scrolling.
      * They control at which DMA cycles the BPLDAT registers are transfered
@@ -414,8 +472,13 @@ public:
     long getConfigItem(Option option) const;
     bool setConfigItem(Option option, long value) override;
     
+#ifdef FORCE_AGNUS_REVISION
+    bool isOCS() const { return FORCE_AGNUS_REVISION == AGNUS_OCS; }
+    bool isECS() const { return FORCE_AGNUS_REVISION != AGNUS_OCS; }
+#else
     bool isOCS() const { return config.revision == AGNUS_OCS; }
     bool isECS() const { return config.revision != AGNUS_OCS; }
+#endif
     
     // Returns the chip identification bits of this Agnus (shows up in VPOSR)
     i16 idBits();
@@ -497,12 +560,12 @@ private:
         worker
         
         >> slot
-        << nextTrigger
 
         << bplEvent
         << dasEvent
         << nextBplEvent
         << nextDasEvent
+        << nextCpuSlot
 
         << hsyncActions
         >> changeRecorder
@@ -524,6 +587,7 @@ private:
         << bplcon0AtDDFStrt
         << dmaconAtDDFStrt
         << dmaDAS
+        << dmaSPR
         << scrollLoresOdd
         << scrollLoresEven
         << scrollHiresOdd
@@ -566,6 +630,7 @@ private:
     isize _size() override { COMPUTE_SNAPSHOT_SIZE }
     isize _load(const u8 *buffer) override { LOAD_SNAPSHOT_ITEMS }
     isize _save(u8 *buffer) override { SAVE_SNAPSHOT_ITEMS }
+    isize didLoadFromBuffer(const u8 *buffer) override;
 
 
     //
@@ -707,8 +772,8 @@ public:
     template <int x> void setSPRxPTH(u16 value);
     template <int x> void pokeSPRxPTL(u16 value);
     template <int x> void setSPRxPTL(u16 value);
-    template <int x> void pokeSPRxPOS(u16 value);
-    template <int x> void pokeSPRxCTL(u16 value);
+    template <int x, Accessor s> void pokeSPRxPOS(u16 value);
+    template <int x, Accessor s> void pokeSPRxCTL(u16 value);
 
 private:
     
@@ -773,13 +838,23 @@ public:
     void clearDasEvents();
 
     // Renews all events in the the DAS event table
-    void updateDasEvents(u16 dmacon);
+    void updateDasEvents(u16 dmacon, u8 sprites);
+
+    /* Adds the DMA slots of a sprite that becomes active in the current line.
+     * A slot in the current cycle is still reachable if the CPU has written
+     * the sprite register, because the CPU owns the previous bus cycle.
+     */
+    template <Accessor s> void enableSpriteSlots(isize nr);
 
 private:
 
     // Updates the jump table for the bplEvent table
     void updateBplJumpTable(i16 end = HPOS_MAX);
 
+    // Looks up or stores the bitplane tables in the table cache
+    bool restoreBplTables(const BplTableKey &key);
+    void cacheBplTables(const BplTableKey &key);
+
     // Updates the jump table for the dasEvent table
     void updateDasJumpTable(i16 end = HPOS_MAX);
 
@@ -885,9 +960,35 @@ public:
     // Returns true if the device is in sync with the E clock
     // bool inSyncWithEClock();
 
-    // Executes the device until the CPU can acquire the bus
-    void executeUntilBusIsFree();
+    /* Executes the device until the CPU can acquire the bus. Most CPU
+     * accesses find the bus free. Hence, this case is handled inline and
+     * only blocked accesses are passed to the slow path. Note that bus
+     * arbitration can't be skipped for lines without DMA, because the
+     * refresh slots are occupied in every line and two CPU accesses in the
+     * same DMA cycle must still be serialized via BUS_CPU.
+     */
+    void executeUntilBusIsFree() {
+        
+        i16 posh = pos.h == 0 ? HPOS_MAX : pos.h - 1;
+        
+        if (busOwner[posh] == BUS_NONE) {
+            busOwner[posh] = BUS_CPU;
+            stats.usage[BUS_CPU]++;
+        } else {
+            waitForBus(posh);
+        }
+    }
     void executeUntilBusIsFreeForCIA();
+
+private:
+
+    // Blocks the CPU until the bus is free (slow path)
+    void waitForBus(i16 posh);
+
+    // Executes all upcoming DMA cycles known to be blocked by bitplane DMA
+    DMACycle skipBplFetchCycles();
+
+public:
     
     // Schedules a register to change its value
     void recordRegisterChange(Cycle delay, u32 addr, u16 value);
@@ -303,7 +303,7 @@ Agnus::allocateBus()
             if (!bltdma()) return false;
 
             // Deny if the CPU has precedence
-            if (bls && !bltpri()) return false;
+            if (bls && !bltpri()) { stats.blitterSlowdowns++; return false; }
 
             // Assign the bus to the Blitter
             busOwner[pos.h] = BUS_BLITTER;
@@ -422,6 +422,11 @@ void
 Agnus::doCopperDMA(u32 addr, u16 value)
 {
     mem.pokeCustom16<ACCESSOR_AGNUS>(addr, value);
+
+    if (mem.tracer.isActive()) {
+        mem.tracer.record<ACCESSOR_AGNUS>(clock, 0xDFF000 | addr, value,
+                                          MemTracer::WRITE | MemTracer::WORD);
+    }
     
     assert(pos.h < HPOS_CNT);
     busOwner[pos.h] = BUS_COPPER;
@@ -461,6 +466,35 @@ Agnus::updateBplEvents(u16 dmacon, u16 bplcon0, int first, int last)
 
     // Do the same if DDFSTRT is never reached in this line
     if (ddfstrtReached == -1) channels = 0;
+
+    // If the whole table is rebuilt, try to restore it from the cache
+    bool cacheable = first == 0 && last == HPOS_MAX;
+    BplTableKey key;
+    
+    if (cacheable) {
+
+        memset(&key, 0, sizeof(key));
+        key.hires = hires;
+        key.channels = (i16)channels;
+        
+        if (hires) {
+            key.strtOdd = ddfHires.strtOdd;
+            key.strtEven = ddfHires.strtEven;
+            key.stopOdd = ddfHires.stopOdd;
+            key.stopEven = ddfHires.stopEven;
+            key.scrollOdd = scrollHiresOdd;
+            key.scrollEven = scrollHiresEven;
+        } else {
+            key.strtOdd = ddfLores.strtOdd;
+            key.strtEven = ddfLores.strtEven;
+            key.stopOdd = ddfLores.stopOdd;
+            key.stopEven = ddfLores.stopEven;
+            key.scrollOdd = scrollLoresOdd;
+            key.scrollEven = scrollLoresEven;
+        }
+
+        if (restoreBplTables(key)) return;
+    }
     
     // Allocate slots
     if (hires) {
@@ -497,6 +531,44 @@ Agnus::updateBplEvents(u16 dmacon, u16 bplcon0, int first, int last)
 
     // Update the drawing flags and update the jump table
     updateDrawingFlags(hires);
+
+    // Remember the result
+    if (cacheable) cacheBplTables(key);
+}
+
+bool
+Agnus::restoreBplTables(const BplTableKey &key)
+{
+    for (isize i = 0; i < bplCacheSize; i++) {
+
+        auto &entry = bplCache[i];
+        if (entry.stamp && entry.key == key) {
+
+            memcpy(bplEvent, entry.bplEvent, sizeof(bplEvent));
+            memcpy(nextBplEvent, entry.nextBplEvent, sizeof(nextBplEvent));
+            memcpy(nextCpuSlot, entry.nextCpuSlot, sizeof(nextCpuSlot));
+            entry.stamp = ++bplCacheStamp;
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+Agnus::cacheBplTables(const BplTableKey &key)
+{
+    // Replace the least recently used entry
+    isize lru = 0;
+    for (isize i = 1; i < bplCacheSize; i++) {
+        if (bplCache[i].stamp < bplCache[lru].stamp) lru = i;
+    }
+
+    auto &entry = bplCache[lru];
+    entry.key = key;
+    entry.stamp = ++bplCacheStamp;
+    memcpy(entry.bplEvent, bplEvent, sizeof(bplEvent));
+    memcpy(entry.nextBplEvent, nextBplEvent, sizeof(nextBplEvent));
+    memcpy(entry.nextCpuSlot, nextCpuSlot, sizeof(nextCpuSlot));
 }
 
 void
@@ -526,17 +598,56 @@ Agnus::updateDrawingFlags(bool hires)
 void
 Agnus::clearDasEvents()
 {
-    updateDasEvents(0);
+    updateDasEvents(0, 0);
 }
 
 void
-Agnus::updateDasEvents(u16 dmacon)
+Agnus::updateDasEvents(u16 dmacon, u8 sprites)
 {
     assert(dmacon < 64);
 
-    // Allocate slots and renew the jump table
+    // Allocate slots
     for (isize i = 0; i < 0x38; i++) dasEvent[i] = dasDMA[dmacon][i];
+
+    // Free the slots of all idle sprites
+    if (dmacon & SPREN) {
+        for (isize nr = 0; nr < 8; nr++) {
+            if (!GET_BIT(sprites, nr)) {
+                dasEvent[0x15 + 4 * nr] = EVENT_NONE;
+                dasEvent[0x17 + 4 * nr] = EVENT_NONE;
+            }
+        }
+    }
+
+    // Renew the jump table
+    updateDasJumpTable(0x38);
+}
+
+template <Accessor s> void
+Agnus::enableSpriteSlots(isize nr)
+{
+    assert(nr < 8);
+
+    if (GET_BIT(dmaSPR, nr) || !(dmaDAS & SPREN)) return;
+    SET_BIT(dmaSPR, nr);
+
+    // Reallocate the slots of this sprite
+    isize slot1 = 0x15 + 4 * nr, slot2 = 0x17 + 4 * nr;
+    dasEvent[slot1] = dasDMA[dmaDAS][slot1];
+    dasEvent[slot2] = dasDMA[dmaDAS][slot2];
     updateDasJumpTable(0x38);
+
+    /* Reschedule the DAS event if one of the slots comes first. The CPU owns
+     * the bus in the previous cycle, so the current cycle hasn't been executed
+     * yet. Agnus (Copper or sprite DMA) writes in the current cycle.
+     */
+    Cycle trigger = slot[SLOT_DAS].triggerCycle;
+    isize pending = trigger == NEVER ? HPOS_CNT : pos.h + AS_DMA_CYCLES(trigger - clock);
+    isize first = s == ACCESSOR_CPU ? pos.h : pos.h + 1;
+
+    for (isize h : { slot1, slot2 }) {
+        if (h >= first && h < pending) { scheduleDasEventForCycle((i16)h); break; }
+    }
 }
 
 void
@@ -549,6 +660,14 @@ Agnus::updateBplJumpTable(i16 end)
         nextBplEvent[i] = next;
         if (bplEvent[i]) next = i;
     }
+
+    // Update the CPU slot table
+    u8 free = HPOS_MAX;
+    for (isize i = HPOS_MAX; i >= 0; i--) {
+        EventID id = (EventID)(bplEvent[i] & ~0b11);
+        if (id == EVENT_NONE || id >= BPL_SR) free = (u8)i;
+        nextCpuSlot[i] = free;
+    }
 }
 
 void
@@ -719,6 +838,9 @@ template u16 Agnus::doSpriteDMA<5>();
 template u16 Agnus::doSpriteDMA<6>();
 template u16 Agnus::doSpriteDMA<7>();
 
+template void Agnus::enableSpriteSlots<ACCESSOR_CPU>(isize nr);
+template void Agnus::enableSpriteSlots<ACCESSOR_AGNUS>(isize nr);
+
 template bool Agnus::allocateBus<BUS_COPPER>();
 template bool Agnus::allocateBus<BUS_BLITTER>();
 
@@ -200,10 +200,10 @@ Agnus::setSPRxPTL(u16 value)
     }
 }
 
-template <int x> void
+template <int x, Accessor s> void
 Agnus::pokeSPRxPOS(u16 value)
 {
-    trace(SPRREG_DEBUG, "pokeSPR%dPOS(%X)\n", x, value);
+    trace(SPRREG_DEBUG, "pokeSPR%dPOS<%s>(%X)\n", x, AccessorEnum::key(s), value);
 
     // Compute the value of the vertical counter that is seen here
     i16 v = (pos.h < 0xDF) ? pos.v : (pos.v + 1);
@@ -214,12 +214,17 @@ Agnus::pokeSPRxPOS(u16 value)
     // Update sprite DMA status
     if (sprVStrt[x] == v) sprDmaState[x] = SPR_DMA_ACTIVE;
     if (sprVStop[x] == v) sprDmaState[x] = SPR_DMA_IDLE;
+
+    // Make sure the sprite has DMA slots if it becomes active in this line
+    if (v == pos.v && (sprDmaState[x] == SPR_DMA_ACTIVE || sprVStop[x] == v)) {
+        enableSpriteSlots<s>(x);
+    }
 }
 
-template <int x> void
+template <int x, Accessor s> void
 Agnus::pokeSPRxCTL(u16 value)
 {
-    trace(SPRREG_DEBUG, "pokeSPR%dCTL(%X)\n", x, value);
+    trace(SPRREG_DEBUG, "pokeSPR%dCTL<%s>(%X)\n", x, AccessorEnum::key(s), value);
 
     // Compute the value of the vertical counter that is seen here
     i16 v = (pos.h < 0xDF) ? pos.v : (pos.v + 1);
@@ -231,6 +236,11 @@ Agnus::pokeSPRxCTL(u16 value)
     // Update sprite DMA status
     if (sprVStrt[x] == v) sprDmaState[x] = SPR_DMA_ACTIVE;
     if (sprVStop[x] == v) sprDmaState[x] = SPR_DMA_IDLE;
+
+    // Make sure the sprite has DMA slots if it becomes active in this line
+    if (v == pos.v && (sprDmaState[x] == SPR_DMA_ACTIVE || sprVStop[x] == v)) {
+        enableSpriteSlots<s>(x);
+    }
 }
 
 bool
@@ -871,23 +881,39 @@ template void Agnus::setSPRxPTL<5>(u16 value);
 template void Agnus::setSPRxPTL<6>(u16 value);
 template void Agnus::setSPRxPTL<7>(u16 value);
 
-template void Agnus::pokeSPRxPOS<0>(u16 value);
-template void Agnus::pokeSPRxPOS<1>(u16 value);
-template void Agnus::pokeSPRxPOS<2>(u16 value);
-template void Agnus::pokeSPRxPOS<3>(u16 value);
-template void Agnus::pokeSPRxPOS<4>(u16 value);
-template void Agnus::pokeSPRxPOS<5>(u16 value);
-template void Agnus::pokeSPRxPOS<6>(u16 value);
-template void Agnus::pokeSPRxPOS<7>(u16 value);
-
-template void Agnus::pokeSPRxCTL<0>(u16 value);
-template void Agnus::pokeSPRxCTL<1>(u16 value);
-template void Agnus::pokeSPRxCTL<2>(u16 value);
-template void Agnus::pokeSPRxCTL<3>(u16 value);
-template void Agnus::pokeSPRxCTL<4>(u16 value);
-template void Agnus::pokeSPRxCTL<5>(u16 value);
-template void Agnus::pokeSPRxCTL<6>(u16 value);
-template void Agnus::pokeSPRxCTL<7>(u16 value);
+template void Agnus::pokeSPRxPOS<0,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<0,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<1,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<1,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<2,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<2,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<3,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<3,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<4,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<4,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<5,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<5,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<6,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<6,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxPOS<7,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxPOS<7,ACCESSOR_AGNUS>(u16 value);
+
+template void Agnus::pokeSPRxCTL<0,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<0,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<1,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<1,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<2,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<2,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<3,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<3,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<4,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<4,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<5,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<5,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<6,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<6,ACCESSOR_AGNUS>(u16 value);
+template void Agnus::pokeSPRxCTL<7,ACCESSOR_CPU>(u16 value);
+template void Agnus::pokeSPRxCTL<7,ACCESSOR_AGNUS>(u16 value);
 
 template void Agnus::pokeDIWSTRT<ACCESSOR_CPU>(u16 value);
 template void Agnus::pokeDIWSTRT<ACCESSOR_AGNUS>(u16 value);
@@ -159,8 +159,35 @@ AgnusInfo;
 
 typedef struct
 {
+    i64 frame;
+
+    // Number of DMA slots in this frame
+    long slots;
+
+    // Number of DMA slots used by each bus owner
     long usage[BUS_COUNT];
-    
+
+    // Number of CPU bus accesses delayed by DMA
+    long cpuWaits;
+
+    // Number of DMA cycles the CPU has been suspended
+    long cpuWaitStates;
+
+    // Number of Blitter bus requests denied by the BLS line
+    long blitterSlowdowns;
+}
+BusStats;
+
+typedef struct
+{
+    long usage[BUS_COUNT];
+    long cpuWaits;
+    long cpuWaitStates;
+    long blitterSlowdowns;
+
+    // Bus statistics of the latest complete frame
+    BusStats lastFrame;
+
     double copperActivity;
     double blitterActivity;
     double diskActivity;
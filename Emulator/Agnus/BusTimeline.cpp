@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "BusTimeline.h"
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+static_assert(sizeof(BusOwner) == 1, "BusOwner must be a single byte");
+
+void
+BusTimeline::recordLine(i64 frame, i16 line, const BusOwner *owner, const u16 *value)
+{
+    // Wait for the beginning of the next frame
+    if (firstFrame < 0) {
+        if (line != 0) return;
+        firstFrame = frame;
+    }
+
+    /* Finish recording if the requested number of frames has been reached.
+     * The file is finalized by the writer thread to keep the emulator thread
+     * from blocking on file I/O. It is closed in stop().
+     */
+    if (frames && frame - firstFrame >= frames) {
+
+        writer.finish();
+        done = true;
+        return;
+    }
+
+    record.frame = frame;
+    record.line = line;
+    memcpy(record.owner, owner, sizeof(record.owner));
+    memcpy(record.value, value, sizeof(record.value));
+
+    writer.write(record);
+    records++;
+}
+
+bool
+BusTimeline::start(const string &path)
+{
+    stop();
+
+    if (!writer.open(path)) return false;
+
+    BusTimelineHeader header = { {'V','A','B','T'}, version, HPOS_CNT };
+    writer.write(header);
+
+    firstFrame = -1;
+    records = 0;
+    done = false;
+    return true;
+}
+
+void
+BusTimeline::stop()
+{
+    writer.close();
+}
+
+void
+BusTimeline::dump(std::ostream& os) const
+{
+    os << "Running: " << (isRunning() ? "yes" : "no") << std::endl;
+    os << " Frames: ";
+    if (frames) os << frames << std::endl; else os << "unlimited" << std::endl;
+    os << "Records: " << records << std::endl;
+    os << "Written: " << writer.bytesWritten() << " bytes" << std::endl;
+    os << "Dropped: " << writer.bytesDropped() << " bytes" << std::endl;
+}
+
+bool
+BusTimeline::convert(const string &path, std::ostream& os)
+{
+    static const char *names[BUS_COUNT] = {
+
+        "NONE", "CPU", "Refresh", "Disk", "Audio",
+        "BPL1", "BPL2", "BPL3", "BPL4", "BPL5", "BPL6",
+        "SPR0", "SPR1", "SPR2", "SPR3", "SPR4", "SPR5", "SPR6", "SPR7",
+        "Copper", "Blitter"
+    };
+    static const char *tracks[] = {
+
+        "", "CPU", "Refresh", "Disk", "Audio", "Bitplanes", "Sprites",
+        "Copper", "Blitter"
+    };
+    auto track = [](isize owner) {
+        return
+        owner >= BUS_COPPER ? owner - BUS_COPPER + 7 :
+        owner >= BUS_SPRITE0 ? 6 :
+        owner >= BUS_BPL1 ? 5 : owner;
+    };
+
+    // Duration of a DMA cycle in microseconds (PAL)
+    const double cycle = 1.0 / 3.546895;
+
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream.is_open()) return false;
+
+    BusTimelineHeader header;
+    stream.read((char *)&header, sizeof(header));
+    if (!stream || memcmp(header.magic, "VABT", 4) != 0) return false;
+    if (header.version != version || header.cycles != HPOS_CNT) return false;
+
+    os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[" << std::endl;
+    os << std::fixed << std::setprecision(3);
+
+    // Name the tracks
+    for (isize i = 1; i < 9; i++) {
+        os << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i;
+        os << ",\"args\":{\"name\":\"" << tracks[i] << "\"}}," << std::endl;
+    }
+
+    BusTimelineRecord rec;
+    i64 prevFrame = -1;
+    i16 prevLine = 0;
+    i64 lineNr = -1;
+
+    while (stream.read((char *)&rec, sizeof(rec))) {
+
+        // Determine the position of this line on the time axis
+        if (rec.frame == prevFrame) {
+            lineNr += rec.line - prevLine;
+        } else {
+            lineNr += 1 + rec.line;
+            os << "{\"name\":\"Frame " << rec.frame << "\",\"ph\":\"i\",\"s\":\"g\"";
+            os << ",\"pid\":1,\"tid\":0,\"ts\":";
+            os << (double)(lineNr - rec.line) * HPOS_CNT * cycle << "}," << std::endl;
+        }
+        prevFrame = rec.frame;
+        prevLine = rec.line;
+
+        // Merge consecutive cycles of the same bus owner into a single slice
+        for (isize h = 0; h < HPOS_CNT; ) {
+
+            isize owner = rec.owner[h], end = h + 1;
+            while (end < HPOS_CNT && rec.owner[end] == owner) end++;
+
+            if (owner > BUS_NONE && owner < BUS_COUNT) {
+
+                os << "{\"name\":\"" << names[owner] << "\",\"ph\":\"X\",\"pid\":1";
+                os << ",\"tid\":" << track(owner);
+                os << ",\"ts\":" << (double)(lineNr * HPOS_CNT + h) * cycle;
+                os << ",\"dur\":" << (double)(end - h) * cycle;
+                os << ",\"args\":{\"frame\":" << rec.frame << ",\"line\":" << rec.line;
+                os << ",\"hpos\":" << h << ",\"value\":" << rec.value[h] << "}}," << std::endl;
+            }
+            h = end;
+        }
+    }
+
+    // Terminate the event list with a metadata record (no trailing comma)
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1";
+    os << ",\"args\":{\"name\":\"Agnus DMA\"}}" << std::endl;
+    os << "]}" << std::endl;
+
+    return true;
+}
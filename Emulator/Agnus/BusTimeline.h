@@ -0,0 +1,110 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "BusTypes.h"
+#include "Constants.h"
+#include "TraceWriter.h"
+#include <ostream>
+
+/* Layout of a bus timeline file:
+ *
+ *     BusTimelineHeader
+ *     BusTimelineRecord (line 1)
+ *     BusTimelineRecord (line 2)
+ *     ...
+ *
+ * Each record stores the bus owner and the transferred data word for all DMA
+ * cycles of a single rasterline. All values are stored in host byte order.
+ */
+struct BusTimelineHeader
+{
+    char magic[4];
+    u16 version;
+    u16 cycles;
+};
+
+struct BusTimelineRecord
+{
+    i64 frame;
+    i16 line;
+    i8 owner[HPOS_CNT];
+    u16 value[HPOS_CNT];
+};
+
+/* The bus timeline captures the contents of the bus usage tables for every
+ * rasterline in a range of frames. Records are handed over to a background
+ * thread via a lock-free ring buffer. If the writer falls behind, records
+ * are dropped instead of stalling the emulator.
+ */
+class BusTimeline
+{
+public:
+
+    static constexpr u16 version = 1;
+
+private:
+
+    // Number of frames to record (0 = unlimited)
+    i64 frames = 0;
+
+    // Indicates that the requested number of frames has been recorded
+    bool done = false;
+
+    // The first recorded frame (-1 = recording hasn't started yet)
+    i64 firstFrame = -1;
+
+    // Number of recorded lines
+    u64 records = 0;
+
+    // The record that is currently assembled
+    BusTimelineRecord record;
+
+    // Output stream
+    util::TraceWriter writer;
+
+
+    //
+    // Configuring
+    //
+
+public:
+
+    void setFrames(i64 value) { frames = value; }
+    i64 getFrames() const { return frames; }
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Records the bus usage tables of a completed rasterline
+    void recordLine(i64 frame, i16 line, const BusOwner *owner, const u16 *value);
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Starts or stops streaming records into a file
+    bool start(const string &path);
+    void stop();
+    bool isRunning() const { return writer.isOpen() && !done; }
+
+    // Prints some information about the current state
+    void dump(std::ostream& os) const;
+
+    // Converts a timeline file into the Chrome trace event format
+    static bool convert(const string &path, std::ostream& os);
+};
@@ -0,0 +1,115 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "CopProfiler.h"
+#include "Constants.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+CopProfiler::CopProfiler()
+{
+    clear();
+}
+
+void
+CopProfiler::clear()
+{
+    memset(&current, 0, sizeof(current));
+    memset(history, 0, sizeof(history));
+    lastLine = -1;
+    frames = 0;
+}
+
+void
+CopProfiler::endFrame(i64 nr)
+{
+    current.frame = nr;
+    history[frames % historySize] = current;
+    frames++;
+
+    memset(&current, 0, sizeof(current));
+    lastLine = -1;
+}
+
+const CopProfileFrame &
+CopProfiler::getFrame(isize nr) const
+{
+    assert(nr >= 0 && nr < count());
+    return history[(frames - 1 - nr) % historySize];
+}
+
+void
+CopProfiler::dump(std::ostream& os, isize count) const
+{
+    auto n = this->count();
+
+    os << "Frames: " << std::dec << n << std::endl;
+    if (n == 0) return;
+
+    // Accumulate all frames in the history buffer
+    u64 moves = 0, waits = 0, skips = 0, cycles = 0, lines = 0;
+    u64 writes[256] = { };
+
+    for (isize i = 0; i < n; i++) {
+
+        auto &f = getFrame(i);
+        moves += f.moves;
+        waits += f.waits;
+        skips += f.skips;
+        cycles += f.cycles;
+        lines += f.lines;
+        for (isize r = 0; r < 256; r++) writes[r] += f.writes[r];
+    }
+
+    os << std::fixed << std::setprecision(1);
+    os << "Average per frame:" << std::endl;
+    os << "    MOVE:   " << std::setw(10) << (double)moves / n << std::endl;
+    os << "    WAIT:   " << std::setw(10) << (double)waits / n << std::endl;
+    os << "    SKIP:   " << std::setw(10) << (double)skips / n << std::endl;
+    os << "    Cycles: " << std::setw(10) << (double)cycles / n << std::endl;
+    os << "    Lines:  " << std::setw(10) << (double)lines / n << std::endl;
+
+    // Sort all registers with at least one write by their write count
+    std::vector<isize> regs;
+    for (isize r = 0; r < 256; r++) if (writes[r]) regs.push_back(r);
+    std::stable_sort(regs.begin(), regs.end(), [&](isize a, isize b) {
+        return writes[a] > writes[b];
+    });
+
+    os << "Register   Writes / frame" << std::endl;
+
+    for (isize i = 0; i < count && i < (isize)regs.size(); i++) {
+
+        auto r = regs[i];
+
+        os << std::left << std::setw(10) << regName((u32)(r << 1)) << std::right;
+        os << std::setw(15) << (double)writes[r] / n << std::endl;
+    }
+}
+
+void
+CopProfiler::exportCSV(std::ostream& os) const
+{
+    os << "frame,moves,waits,skips,cycles,lines";
+    for (isize r = 0; r < 256; r++) os << "," << regName((u32)(r << 1));
+    os << std::endl;
+
+    for (isize i = count() - 1; i >= 0; i--) {
+
+        auto &f = getFrame(i);
+
+        os << f.frame << "," << f.moves << "," << f.waits << "," << f.skips;
+        os << "," << f.cycles << "," << f.lines;
+        for (isize r = 0; r < 256; r++) os << "," << f.writes[r];
+        os << std::endl;
+    }
+}
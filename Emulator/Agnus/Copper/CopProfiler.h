@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Aliases.h"
+#include <ostream>
+
+/* Statistics of a single frame. Register writes are indexed by the register
+ * number, i.e., the custom register offset divided by two. Cycles count all
+ * DMA cycles the Copper has occupied, which are the cycles the CPU could not
+ * use for accessing Chip memory.
+ */
+struct CopProfileFrame
+{
+    i64 frame;
+    u32 moves;
+    u32 waits;
+    u32 skips;
+    u32 cycles;
+    u32 lines;
+    u32 writes[256];
+};
+
+/* The Copper profiler collects per-frame execution statistics. The records of
+ * the most recent frames are kept in a preallocated ring buffer. Profiling is
+ * only performed if COP_PROFILE is set in config.h. Otherwise, all calls into
+ * the collector are optimized away by the compiler.
+ */
+class CopProfiler
+{
+public:
+
+    // Number of frames kept in the history buffer
+    static constexpr isize historySize = 64;
+
+private:
+
+    // Statistics of the current frame
+    CopProfileFrame current;
+
+    // The most recent line with Copper activity
+    isize lastLine = -1;
+
+    // Statistics of the most recent frames
+    CopProfileFrame history[historySize];
+
+    // Number of completed frames
+    i64 frames = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    CopProfiler();
+
+    // Deletes all recorded statistics
+    void clear();
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    void recordMove(u32 reg) { current.moves++; current.writes[(reg >> 1) & 0xFF]++; }
+    void recordWait() { current.waits++; }
+    void recordSkip() { current.skips++; }
+
+    void recordCycle(isize line) {
+        current.cycles++;
+        if (line != lastLine) { current.lines++; lastLine = line; }
+    }
+
+    // Finishes the current frame (called in the VSYNC handler)
+    void endFrame(i64 nr);
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Returns the number of frames in the history buffer
+    isize count() const { return frames < historySize ? (isize)frames : historySize; }
+
+    // Returns a recorded frame (0 = most recent frame)
+    const CopProfileFrame &getFrame(isize nr) const;
+
+    // Prints averages and the most frequently written registers
+    void dump(std::ostream& os, isize count) const;
+
+    // Writes all frames in the history buffer in CSV format
+    void exportCSV(std::ostream& os) const;
+};
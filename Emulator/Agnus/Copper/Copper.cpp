@@ -22,6 +22,9 @@ void
 Copper::_reset(bool hard)
 {
     RESET_SNAPSHOT_ITEMS(hard)
+
+    // Empty the WAIT cache
+    for (isize i = 0; i < waitCacheSize; i++) waitCache[i].pc = UINT32_MAX;
 }
 
 void
@@ -207,6 +210,39 @@ Copper::findMatchNew(Beam &match) const
     return false;
 }
 
+bool
+Copper::findMatchCached(Beam &match)
+{
+    u32 beam = (agnus.pos.v << 8) | agnus.pos.h;
+    u16 comp = getVPHP();
+    u16 mask = getVMHM();
+    i16 numLines = (i16)agnus.frame.numLines();
+
+    auto &entry = waitCache[(coppc >> 2) & (waitCacheSize - 1)];
+
+    // Check for a cache hit
+    if (entry.pc == coppc &&
+        entry.beam == beam &&
+        entry.comp == comp &&
+        entry.mask == mask &&
+        entry.numLines == numLines) {
+
+        if (entry.found) match = entry.match;
+        return entry.found;
+    }
+
+    // Cache miss: Search the wake-up position
+    entry.pc = coppc;
+    entry.beam = beam;
+    entry.comp = comp;
+    entry.mask = mask;
+    entry.numLines = numLines;
+    entry.found = findMatchNew(entry.match);
+
+    if (entry.found) match = entry.match;
+    return entry.found;
+}
+
 bool
 Copper::findHorizontalMatchNew(u32 &match, u32 comp, u32 mask) const
 {
@@ -343,7 +379,7 @@ Copper::scheduleWaitWakeup(bool bfd)
     Beam trigger;
 
     // Find the trigger position for this WAIT command
-    if (findMatchNew(trigger)) {
+    if (findMatchCached(trigger)) {
 
         // In how many cycles do we get there?
         int delay = trigger - agnus.pos;
@@ -509,6 +545,8 @@ Copper::vsyncHandler()
         checkcnt = 0;
         checksum = util::fnv_1a_init32();
     }
+
+    if (COP_PROFILE) profiler.endFrame(agnus.frame.nr);
 }
 
 void
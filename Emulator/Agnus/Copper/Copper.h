@@ -15,6 +15,7 @@
 #include "AmigaComponent.h"
 #include "Beam.h"
 #include "Checksum.h"
+#include "CopProfiler.h"
 
 class Copper : public AmigaComponent
 {
@@ -63,6 +64,27 @@ class Copper : public AmigaComponent
     // Storage for disassembled instruction
     char disassembly[128];
 
+    /* Cache of WAIT wake-up positions. Most Copper lists are static and
+     * execute each WAIT at the same beam position in every frame. Because
+     * the wake-up position only depends on the start position, the
+     * comparison values, and the number of lines in the current frame, the
+     * result of findMatchNew() is cached for each WAIT address and reused if
+     * all inputs match. Modified Copper lists are detected automatically,
+     * because the comparison values are taken from the fetched instruction.
+     */
+    struct WaitCacheEntry {
+        
+        u32 pc;
+        u32 beam;
+        u16 comp;
+        u16 mask;
+        i16 numLines;
+        bool found;
+        Beam match;
+    };
+    static constexpr isize waitCacheSize = 256;
+    WaitCacheEntry waitCache[waitCacheSize];
+
 public:
 
     // Indicates if Copper is currently servicing an event (for debugging only)
@@ -71,6 +93,9 @@ public:
     // Temporary debug flag
     bool verbose = false;
 
+    // Per-frame execution statistics (only collected if COP_PROFILE is set)
+    CopProfiler profiler;
+
 
     //
     // Debugging
@@ -194,6 +219,9 @@ private:
     bool findMatch(Beam &result) const;
     bool findMatchNew(Beam &result) const;
 
+    // Cached variant of findMatchNew()
+    bool findMatchCached(Beam &result);
+
     // Called by findMatch() to determine the vertical trigger position
     bool findVerticalMatch(i16 vStrt, i16 vComp, i16 vMask, i16 &result) const;
 
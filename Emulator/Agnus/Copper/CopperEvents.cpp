@@ -80,6 +80,8 @@ Copper::serviceEvent(EventID id)
             cop1ins = agnus.doCopperDMA(coppc);
             advancePC();
 
+            if (COP_PROFILE) profiler.recordCycle(agnus.pos.v);
+
             if (COP_CHECKSUM) {
                 checkcnt++;
                 checksum = util::fnv_1a_it32(checksum, cop1ins);
@@ -108,6 +110,7 @@ Copper::serviceEvent(EventID id)
             advancePC();
 
             if (COP_CHECKSUM) checksum = util::fnv_1a_it32(checksum, cop2ins);
+            if (COP_PROFILE) profiler.recordCycle(agnus.pos.v);
 
             // Extract register number from the first instruction word
             reg = (cop1ins & 0x1FE);
@@ -121,6 +124,8 @@ Copper::serviceEvent(EventID id)
             // Only proceed if the skip flag is not set
             if (skip) { skip = false; break; }
 
+            if (COP_PROFILE) profiler.recordMove(reg);
+
             // Write value into custom register
             switch (reg) {
                 case 0x88:
@@ -149,6 +154,11 @@ Copper::serviceEvent(EventID id)
 
             if (COP_CHECKSUM) checksum = util::fnv_1a_it32(checksum, cop2ins);
 
+            if (COP_PROFILE) {
+                profiler.recordCycle(agnus.pos.v);
+                isWaitCmd() ? profiler.recordWait() : profiler.recordSkip();
+            }
+
             // Fork execution depending on the instruction type
             schedule(isWaitCmd() ? COP_WAIT1 : COP_SKIP1);
             break;
@@ -248,7 +258,9 @@ Copper::serviceEvent(EventID id)
             // debug("COP_JMP1\n");
 
             // The bus is not needed in this cycle, but still allocated
-            (void)agnus.allocateBus<BUS_COPPER>();
+            if (agnus.allocateBus<BUS_COPPER>()) {
+                if (COP_PROFILE) profiler.recordCycle(agnus.pos.v);
+            }
 
             // In cycle $E0, Copper continues with the next state in $E1 (?!)
             if (agnus.pos.h == 0xE0) {
@@ -278,6 +290,7 @@ Copper::serviceEvent(EventID id)
             // Allocate the bus
             // TODO: FIND OUT IF THE BUS IS REALLY ALLOCATED IN THIS STATE
             if (agnus.copdma() && !agnus.allocateBus<BUS_COPPER>()) { reschedule(); break; }
+            if (COP_PROFILE && agnus.copdma()) profiler.recordCycle(agnus.pos.v);
 
             switchToCopperList(1);
             activeInThisFrame = agnus.copdma();
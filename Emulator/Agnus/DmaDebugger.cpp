@@ -62,6 +62,25 @@ DmaDebugger::getInfo()
         getColor(BUS_BPL1, result.bitplaneColor);
         getColor(BUS_CPU, result.cpuColor);
         getColor(BUS_REFRESH, result.refreshColor);
+
+        auto &profiler = agnus.copper.profiler;
+        if (profiler.count()) {
+
+            auto &frame = profiler.getFrame(0);
+            result.copperMoves = frame.moves;
+            result.copperWaits = frame.waits;
+            result.copperSkips = frame.skips;
+            result.copperCycles = frame.cycles;
+            result.copperLines = frame.lines;
+
+        } else {
+
+            result.copperMoves = 0;
+            result.copperWaits = 0;
+            result.copperSkips = 0;
+            result.copperCycles = 0;
+            result.copperLines = 0;
+        }
     }
 
     return result;
@@ -73,5 +73,12 @@ typedef struct
     double bitplaneColor[3];
     double cpuColor[3];
     double refreshColor[3];
+
+    // Copper statistics of the latest frame (requires COP_PROFILE)
+    isize copperMoves;
+    isize copperWaits;
+    isize copperSkips;
+    isize copperCycles;
+    isize copperLines;
 }
 DMADebuggerInfo;
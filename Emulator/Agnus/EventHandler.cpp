@@ -443,87 +443,59 @@ Agnus::scheduleNextREGEvent()
     scheduleAbs<SLOT_REG>(nextTrigger, REG_CHANGE);
 }
 
+void
+Agnus::rebuildTriggerTree()
+{
+    for (isize i = 0; i < treeLeaves; i++) triggerTree[treeLeaves + i] = NEVER;
+    for (isize i = 0; i < SLOT_COUNT; i++) {
+        if (leafOf[i] >= 0) triggerTree[treeLeaves + leafOf[i]] = slot[i].triggerCycle;
+    }
+    for (isize n = treeLeaves - 1; n > 0; n--) {
+        triggerTree[n] = std::min(triggerTree[2 * n], triggerTree[2 * n + 1]);
+    }
+}
+
 void
 Agnus::executeEventsUntil(Cycle cycle) {
 
     //
-    // Check primary slots
+    // Serve all due slots
     //
-
-    if (isDue<SLOT_RAS>(cycle)) {
-        serviceRASEvent();
-    }
-    if (isDue<SLOT_REG>(cycle)) {
-        serviceREGEvent(cycle);
-    }
-    if (isDue<SLOT_CIAA>(cycle)) {
-        serviceCIAEvent<0>();
-    }
-    if (isDue<SLOT_CIAB>(cycle)) {
-        serviceCIAEvent<1>();
-    }
-    if (isDue<SLOT_BPL>(cycle)) {
-        serviceBPLEvent();
-    }
-    if (isDue<SLOT_DAS>(cycle)) {
-        serviceDASEvent();
-    }
-    if (isDue<SLOT_COP>(cycle)) {
-        copper.serviceEvent(slot[SLOT_COP].id);
-    }
-    if (isDue<SLOT_BLT>(cycle)) {
-        blitter.serviceEvent();
+    
+    for (isize p = nextDueLeaf(0, cycle); p >= 0; p = nextDueLeaf(p + 1, cycle)) {
+
+        switch (servingOrder[p]) {
+
+            case SLOT_RAS:  serviceRASEvent(); break;
+            case SLOT_REG:  serviceREGEvent(cycle); break;
+            case SLOT_CIAA: serviceCIAEvent<0>(); break;
+            case SLOT_CIAB: serviceCIAEvent<1>(); break;
+            case SLOT_BPL:  serviceBPLEvent(); break;
+            case SLOT_DAS:  serviceDASEvent(); break;
+            case SLOT_COP:  copper.serviceEvent(slot[SLOT_COP].id); break;
+            case SLOT_BLT:  blitter.serviceEvent(); break;
+            case SLOT_CH0:  paula.channel0.serviceEvent(); break;
+            case SLOT_CH1:  paula.channel1.serviceEvent(); break;
+            case SLOT_CH2:  paula.channel2.serviceEvent(); break;
+            case SLOT_CH3:  paula.channel3.serviceEvent(); break;
+            case SLOT_DSK:  paula.diskController.serviceDiskEvent(); break;
+            case SLOT_DCH:  paula.diskController.serviceDiskChangeEvent(); break;
+            case SLOT_VBL:  serviceVblEvent(); break;
+            case SLOT_IRQ:  paula.serviceIrqEvent(); break;
+            case SLOT_KBD:  keyboard.serviceKeyboardEvent(slot[SLOT_KBD].id); break;
+            case SLOT_TXD:  uart.serviceTxdEvent(slot[SLOT_TXD].id); break;
+            case SLOT_RXD:  uart.serviceRxdEvent(slot[SLOT_RXD].id); break;
+            case SLOT_POT:  paula.servicePotEvent(slot[SLOT_POT].id); break;
+            case SLOT_IPL:  paula.serviceIplEvent(); break;
+            case SLOT_INS:  serviceINSEvent(); break;
+
+            default:
+                assert(false);
+        }
     }
 
     if (isDue<SLOT_SEC>(cycle)) {
 
-        //
-        // Check secondary slots
-        //
-
-        if (isDue<SLOT_CH0>(cycle)) {
-            paula.channel0.serviceEvent();
-        }
-        if (isDue<SLOT_CH1>(cycle)) {
-            paula.channel1.serviceEvent();
-        }
-        if (isDue<SLOT_CH2>(cycle)) {
-            paula.channel2.serviceEvent();
-        }
-        if (isDue<SLOT_CH3>(cycle)) {
-            paula.channel3.serviceEvent();
-        }
-        if (isDue<SLOT_DSK>(cycle)) {
-            paula.diskController.serviceDiskEvent();
-        }
-        if (isDue<SLOT_DCH>(cycle)) {
-            paula.diskController.serviceDiskChangeEvent();
-        }
-        if (isDue<SLOT_VBL>(cycle)) {
-            serviceVblEvent();
-        }
-        if (isDue<SLOT_IRQ>(cycle)) {
-            paula.serviceIrqEvent();
-        }
-        if (isDue<SLOT_KBD>(cycle)) {
-            keyboard.serviceKeyboardEvent(slot[SLOT_KBD].id);
-        }
-        if (isDue<SLOT_TXD>(cycle)) {
-            uart.serviceTxdEvent(slot[SLOT_TXD].id);
-        }
-        if (isDue<SLOT_RXD>(cycle)) {
-            uart.serviceRxdEvent(slot[SLOT_RXD].id);
-        }
-        if (isDue<SLOT_POT>(cycle)) {
-            paula.servicePotEvent(slot[SLOT_POT].id);
-        }
-        if (isDue<SLOT_IPL>(cycle)) {
-            paula.serviceIplEvent();
-        }
-        if (isDue<SLOT_INS>(cycle)) {
-            serviceINSEvent();
-        }
-
         // Determine the next trigger cycle for all secondary slots
         Cycle nextSecTrigger = slot[SLOT_SEC + 1].triggerCycle;
         for (isize i = SLOT_SEC + 2; i < SLOT_COUNT; i++)
@@ -533,10 +505,4 @@ Agnus::executeEventsUntil(Cycle cycle) {
         // Update the secondary table trigger in the primary table
         rescheduleAbs<SLOT_SEC>(nextSecTrigger);
     }
-
-    // Determine the next trigger cycle for all primary slots
-    nextTrigger = slot[0].triggerCycle;
-    for (isize i = 1; i <= SLOT_SEC; i++)
-        if (slot[i].triggerCycle < nextTrigger)
-            nextTrigger = slot[i].triggerCycle;
 }
@@ -63,6 +63,73 @@ template<EventSlot s> bool isPending() const { return slot[s].triggerCycle != NE
 template<EventSlot s> bool isDue(Cycle cycle) const { return cycle >= slot[s].triggerCycle; }
 
 
+//
+// Maintaining the trigger tree
+//
+
+private:
+
+/* Order in which due slots are served. SLOT_SEC is not part of the tree,
+ * because all secondary slots are stored in the tree directly.
+ */
+static constexpr EventSlot servingOrder[] = {
+
+    SLOT_RAS, SLOT_REG, SLOT_CIAA, SLOT_CIAB, SLOT_BPL, SLOT_DAS, SLOT_COP,
+    SLOT_BLT, SLOT_CH0, SLOT_CH1, SLOT_CH2, SLOT_CH3, SLOT_DSK, SLOT_DCH,
+    SLOT_VBL, SLOT_IRQ, SLOT_KBD, SLOT_TXD, SLOT_RXD, SLOT_POT, SLOT_IPL,
+    SLOT_INS
+};
+
+// Position of each slot in servingOrder (indexed by EventSlot)
+static constexpr isize leafOf[SLOT_COUNT] = {
+
+    1, 0, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, 12, 13, 14, 15, 20, 16, 17,
+    18, 19, 21
+};
+
+// Propagates a changed trigger cycle towards the root
+template<EventSlot s> void updateTriggerTree(Cycle cycle)
+{
+    if (s == SLOT_SEC) return;
+
+    isize n = treeLeaves + leafOf[s];
+    triggerTree[n] = cycle;
+
+    for (n >>= 1; n; n >>= 1) {
+
+        Cycle min = std::min(triggerTree[2 * n], triggerTree[2 * n + 1]);
+        if (triggerTree[n] == min) break;
+        triggerTree[n] = min;
+    }
+}
+
+// Recomputes the trigger tree from scratch
+void rebuildTriggerTree();
+
+// Returns the first leaf at or after position p that is due (-1 if none)
+isize nextDueLeaf(isize p, Cycle cycle) const
+{
+    if (p >= treeLeaves) return -1;
+
+    isize n = treeLeaves + p;
+    if (triggerTree[n] > cycle) {
+
+        // Climb up until a right sibling contains a due leaf
+        for (;; n >>= 1) {
+
+            if (n == 1) return -1;
+            if (!(n & 1) && triggerTree[n + 1] <= cycle) { n++; break; }
+        }
+
+        // Descend to the leftmost due leaf
+        while (n < treeLeaves) {
+            n = triggerTree[2 * n] <= cycle ? 2 * n : 2 * n + 1;
+        }
+    }
+    return n - treeLeaves;
+}
+
+
 //
 // Scheduling events
 //
@@ -101,7 +168,7 @@ template<EventSlot s> void scheduleAbs(Cycle cycle, EventID id)
 {
     slot[s].triggerCycle = cycle;
     slot[s].id = id;
-    if (cycle < nextTrigger) nextTrigger = cycle;
+    updateTriggerTree<s>(cycle);
 
     if (isSecondarySlot(s) && cycle < slot[SLOT_SEC].triggerCycle)
         slot[SLOT_SEC].triggerCycle = cycle;
@@ -159,7 +226,7 @@ template<EventSlot s> void schedulePos(i16 vpos, i16 hpos, EventID id, i64 data)
 template<EventSlot s> void rescheduleAbs(Cycle cycle)
 {
     slot[s].triggerCycle = cycle;
-    if (cycle < nextTrigger) nextTrigger = cycle;
+    updateTriggerTree<s>(cycle);
     
      if (isSecondarySlot(s) && cycle < slot[SLOT_SEC].triggerCycle)
          slot[SLOT_SEC].triggerCycle = cycle;
@@ -185,6 +252,7 @@ template<EventSlot s> void cancel()
     slot[s].id = (EventID)0;
     slot[s].data = 0;
     slot[s].triggerCycle = NEVER;
+    updateTriggerTree<s>(NEVER);
 }
 
 
@@ -307,6 +307,9 @@ CPU::didLoadFromBuffer(const u8 *buffer)
      */
     debugger.breakpoints.setNeedsCheck(debugger.breakpoints.elements() != 0);
     debugger.watchpoints.setNeedsCheck(debugger.watchpoints.elements() != 0);
+    debugger.profiler.setNeedsCheck(debugger.profiler.isEnabled());
+    debugger.coverage.setNeedsCheck(debugger.coverage.isEnabled());
+    debugger.tracer.setNeedsCheck(debugger.tracer.isRunning());
     return 0;
 }
 
@@ -342,14 +345,77 @@ CPU::disassembleRecordedPC(isize i)
 const char *
 CPU::disassembleInstr(u32 addr, isize *len)
 {
-    static char result[128];
+    static char result[DASM_MAX_LEN];
 
-    int l = disassemble(addr, result);
+    synchronized {
 
-    if (len) *len = (isize)l;
+        auto &entry = lookupDasmCache(addr);
+        strcpy(result, entry.instr);
+        if (len) *len = (isize)entry.len;
+    }
     return result;
 }
 
+isize
+CPU::disassembleRange(u32 addr, isize cnt, DasmLine *buffer)
+{
+    synchronized {
+
+        for (isize i = 0; i < cnt; i++) {
+
+            auto &entry = lookupDasmCache(addr);
+
+            buffer[i].addr = addr;
+            buffer[i].len = (isize)entry.len;
+            memcpy(buffer[i].instr, entry.instr, sizeof(buffer[i].instr));
+            addr += entry.len;
+        }
+    }
+    return cnt;
+}
+
+void
+CPU::clearDasmCache()
+{
+    synchronized {
+        for (isize i = 0; i < dasmCacheSize; i++) dasmCache[i].len = 0;
+    }
+}
+
+const CPU::DasmCacheEntry &
+CPU::lookupDasmCache(u32 addr)
+{
+    auto &entry = dasmCache[(addr >> 1) & (dasmCacheSize - 1)];
+
+    // Check for a cache hit
+    if (entry.len && entry.addr == addr && entry.hex == hex && entry.upper == upper) {
+
+        auto gen0 = mem.getGeneration(addr);
+        auto gen1 = mem.getGeneration(addr + entry.len - 1);
+        
+        if (gen0 && gen1 && gen0 == entry.gen[0] && gen1 == entry.gen[1]) {
+            return entry;
+        }
+    }
+
+    // Cache miss: Run the disassembler
+    char tmp[128];
+    int len = disassemble(addr, tmp);
+    assert(len >= 2 && len <= 10);
+    assert(strlen(tmp) < DASM_MAX_LEN);
+
+    entry.addr = addr;
+    entry.len = (i8)len;
+    entry.hex = hex;
+    entry.upper = upper;
+    entry.gen[0] = mem.getGeneration(addr);
+    entry.gen[1] = mem.getGeneration(addr + len - 1);
+    memcpy(entry.instr, tmp, std::min(strlen(tmp) + 1, sizeof(entry.instr)));
+    entry.instr[DASM_MAX_LEN - 1] = 0;
+
+    return entry;
+}
+
 const char *
 CPU::disassembleWords(u32 addr, isize len)
 {
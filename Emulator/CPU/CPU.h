@@ -18,6 +18,24 @@ class CPU : public moira::Moira {
     // Result of the latest inspection
     CPUInfo info;
 
+    /* Cache of disassembled instructions. The cache is direct-mapped and
+     * indexed by the instruction address. Each entry stores the write
+     * generations of the memory pages holding the first and the last
+     * instruction word. An entry is only reused if both pages are unchanged
+     * and the disassembler format hasn't changed in the meantime.
+     */
+    static const isize dasmCacheSize = 2048;
+    struct DasmCacheEntry {
+        
+        u32 addr;
+        i8 len;
+        bool hex;
+        bool upper;
+        u64 gen[2];
+        char instr[DASM_MAX_LEN];
+    };
+    DasmCacheEntry dasmCache[dasmCacheSize] = { };
+
     
     //
     // Initializing
@@ -175,10 +193,21 @@ public:
 
     // Disassembles the instruction at the specified address
     const char *disassembleInstr(u32 addr, isize *len);
+
+    // Disassembles cnt consecutive instructions into a provided buffer
+    isize disassembleRange(u32 addr, isize cnt, DasmLine *buffer);
+
+    // Deletes all cached disassembler results
+    void clearDasmCache();
     const char *disassembleWords(u32 addr, isize len);
     const char *disassembleAddr(u32 addr);
 
     // Disassembles the currently executed instruction
     const char *disassembleInstr(isize *len);
     const char *disassembleWords(isize len);
+
+private:
+
+    // Returns the cached disassembler result for an address
+    const DasmCacheEntry &lookupDasmCache(u32 addr);
 };
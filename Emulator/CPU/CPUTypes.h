@@ -13,6 +13,9 @@
 
 #define CPUINFO_INSTR_COUNT 256
 
+// Maximum length of a disassembled instruction (including the terminator)
+#define DASM_MAX_LEN 96
+
 typedef struct
 {
     u32 pc0;
@@ -23,3 +26,11 @@ typedef struct
     u16 sr;
 }
 CPUInfo;
+
+typedef struct
+{
+    u32 addr;
+    isize len;
+    char instr[DASM_MAX_LEN];
+}
+DasmLine;
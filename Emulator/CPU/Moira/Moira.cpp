@@ -147,6 +147,21 @@ Moira::execute()
         debugger.logInstruction();
     }
 
+    // If the profiler is running, sample the program counter
+    if (flags & CPU_PROFILE) {
+        debugger.profiler.sample();
+    }
+
+    // If coverage recording is enabled, mark the instruction as executed
+    if (flags & CPU_COVERAGE) {
+        debugger.coverage.record(reg.pc0);
+    }
+
+    // If streaming is enabled, write the instruction into the trace file
+    if (flags & CPU_STREAM_INSTRUCTION) {
+        debugger.tracer.record();
+    }
+
     // Execute the instruction
     reg.pc += 2;
     (this->*exec[queue.ird])(queue.ird);
@@ -342,7 +357,7 @@ Moira::disassemble(u32 addr, char *str)
     }
 
     u32 pc     = addr;
-    u16 opcode = read16Dasm(pc);
+    u16 opcode = dasmWord(pc);
 
     StrWriter writer(str, hex, upper);
 
@@ -352,6 +367,19 @@ Moira::disassemble(u32 addr, char *str)
     return pc - addr + 2;
 }
 
+int
+Moira::disassemble(u32 addr, const u16 *words, int cnt, char *str)
+{
+    dasmWords = words;
+    dasmBase = addr;
+    dasmCount = cnt;
+
+    int result = disassemble(addr, str);
+
+    dasmWords = nullptr;
+    return result;
+}
+
 void
 Moira::disassembleWord(u32 value, char *str)
 {
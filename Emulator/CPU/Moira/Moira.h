@@ -27,6 +27,9 @@ class Moira : public AmigaComponent {
     friend class Debugger;
     friend class Breakpoints;
     friend class Watchpoints;
+    friend class Profiler;
+    friend class Coverage;
+    friend class Tracer;
 
 protected:
 
@@ -88,6 +91,18 @@ protected:
      *
      * CPU_CHECK_WP:
      *    This flag indicates whether the CPU should check fo watchpoints.
+     *
+     * CPU_PROFILE:
+     *    This flag is set if the profiler is running. If set, the CPU
+     *    periodically samples the program counter.
+     *
+     * CPU_COVERAGE:
+     *    This flag is set if code coverage recording is enabled. If set, the
+     *    CPU marks the address of each executed instruction in a bitmap.
+     *
+     * CPU_STREAM_INSTRUCTION:
+     *    This flag is set if instruction streaming is enabled. If set, the
+     *    CPU writes a trace record for each executed instruction.
      */
     int flags;
     static const int CPU_IS_HALTED         = (1 << 8);
@@ -98,6 +113,9 @@ protected:
     static const int CPU_TRACE_FLAG        = (1 << 13);
     static const int CPU_CHECK_BP          = (1 << 14);
     static const int CPU_CHECK_WP          = (1 << 15);
+    static const int CPU_PROFILE           = (1 << 16);
+    static const int CPU_COVERAGE          = (1 << 17);
+    static const int CPU_STREAM_INSTRUCTION = (1 << 18);
 
     // Number of elapsed cycles since powerup
     i64 clock;
@@ -124,6 +142,11 @@ protected:
     // Jump table holding the disassebler handlers
     typedef void (Moira::*DasmPtr)(StrWriter&, u32&, u16);
     DasmPtr *dasm = nullptr;
+
+    // If set, the disassembler reads instruction words from this buffer
+    const u16 *dasmWords = nullptr;
+    u32 dasmBase = 0;
+    int dasmCount = 0;
     
 private:
     
@@ -179,6 +202,9 @@ public:
     // Disassembles a single instruction and returns the instruction size
     int disassemble(u32 addr, char *str);
 
+    // Disassembles an instruction stored in a buffer (e.g., a recorded trace)
+    int disassemble(u32 addr, const u16 *words, int cnt, char *str);
+
     // Returns a textual representation for a single word
     void disassembleWord(u32 value, char *str);
 
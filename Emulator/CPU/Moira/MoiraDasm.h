@@ -14,6 +14,9 @@
 // Reads a word from memory and increments addr
 template <Size S> u32 dasmRead(u32 &addr);
 
+// Reads a word from memory or from the buffer passed to disassemble()
+u16 dasmWord(u32 addr);
+
 // Computes the number of extension words of instructions in full extension format
 int baseDispWords(u16 ext);
 int outerDispWords(u16 ext);
@@ -11,14 +11,14 @@ template <> u32
 Moira::dasmRead<Byte>(u32 &addr)
 {
     addr += 2;
-    return read16Dasm(addr) & 0xFF;
+    return dasmWord(addr) & 0xFF;
 }
 
 template <> u32
 Moira::dasmRead<Word>(u32 &addr)
 {
     addr += 2;
-    return read16Dasm(addr);
+    return dasmWord(addr);
 }
 
 template <> u32
@@ -29,6 +29,17 @@ Moira::dasmRead<Long>(u32 &addr)
     return result;
 }
 
+u16
+Moira::dasmWord(u32 addr)
+{
+    if (dasmWords) {
+
+        u32 index = (addr - dasmBase) >> 1;
+        return index < (u32)dasmCount ? dasmWords[index] : 0;
+    }
+    return read16Dasm(addr);
+}
+
 int
 Moira::baseDispWords(u16 ext)
 {
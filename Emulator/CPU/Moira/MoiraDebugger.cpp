@@ -11,6 +11,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <algorithm>
 
 namespace moira {
 
@@ -43,11 +44,8 @@ Guards::guardWithNr(long nr)
 Guard *
 Guards::guardAtAddr(u32 addr)
 {
-    for (int i = 0; i < count; i++) {
-        if (guards[i].addr == addr) return &guards[i];
-    }
-
-    return nullptr;
+    auto it = index.find(addr);
+    return it != index.end() ? &guards[it->second] : nullptr;
 }
 
 bool
@@ -100,6 +98,7 @@ Guards::addAt(u32 addr, long skip)
     guards[count].enabled = true;
     guards[count].hits = 0;
     guards[count].skip = skip;
+    indexGuard(count);
     count++;
     setNeedsCheck(true);
 }
@@ -117,8 +116,12 @@ Guards::removeAt(u32 addr)
 
         if (guards[i].addr == addr) {
 
+            unindexGuard(i);
             for (int j = i; j + 1 < count; j++) guards[j] = guards[j + 1];
             count--;
+
+            // Renumber all guards that have moved up
+            for (int j = i; j < count; j++) index[guards[j].addr] = j;
             break;
         }
     }
@@ -130,8 +133,10 @@ Guards::replace(long nr, u32 addr)
 {
     if (nr >= count || isSetAt(addr)) return;
     
+    unindexGuard(nr);
     guards[nr].addr = addr;
     guards[nr].hits = 0;
+    indexGuard(nr);
 }
 
 bool
@@ -153,11 +158,47 @@ Guards::setEnableAt(u32 addr, bool value)
     if (guard) guard->enabled = value;
 }
 
+void
+Guards::indexGuard(long nr)
+{
+    u32 bit = (guards[nr].addr >> pageBits) & (filterSize - 1);
+
+    pageCount[bit]++;
+    pageFilter[bit >> 6] |= 1ULL << (bit & 63);
+    index[guards[nr].addr] = nr;
+}
+
+void
+Guards::unindexGuard(long nr)
+{
+    u32 bit = (guards[nr].addr >> pageBits) & (filterSize - 1);
+
+    assert(pageCount[bit] > 0);
+    if (--pageCount[bit] == 0) pageFilter[bit >> 6] &= ~(1ULL << (bit & 63));
+    index.erase(guards[nr].addr);
+}
+
+void
+Guards::updateIndex()
+{
+    memset(pageFilter, 0, sizeof(pageFilter));
+    memset(pageCount, 0, sizeof(pageCount));
+    index.clear();
+
+    for (long i = 0; i < count; i++) indexGuard(i);
+}
+
 bool
 Guards::eval(u32 addr, Size S)
 {
-    for (int i = 0; i < count; i++)
-        if (guards[i].eval(addr, S)) return true;
+    // Quick exit if no guard is located in the affected page(s)
+    if (!mayHit(addr) && !mayHit(addr + S - 1)) return false;
+
+    for (u32 a = addr; a < addr + S; a++) {
+
+        auto it = index.find(a);
+        if (it != index.end() && guards[it->second].eval(addr, S)) return true;
+    }
 
     return false;
 }
@@ -182,11 +223,376 @@ Watchpoints::setNeedsCheck(bool value)
     }
 }
 
+//
+// Profiler
+//
+
+void
+Profiler::enable()
+{
+    if (!buckets) {
+        buckets = new ProfBucket[bucketCount];
+        clear();
+    }
+
+    countdown = interval;
+    lastClock = moira.clock;
+    enabled = true;
+    setNeedsCheck(true);
+}
+
+void
+Profiler::disable()
+{
+    enabled = false;
+    setNeedsCheck(false);
+}
+
+void
+Profiler::setInterval(long value)
+{
+    interval = std::max(value, 1L);
+    countdown = interval;
+}
+
+void
+Profiler::clear()
+{
+    if (buckets) memset(buckets, 0, bucketCount * sizeof(ProfBucket));
+    lastClock = moira.clock;
+}
+
+void
+Profiler::setNeedsCheck(bool value)
+{
+    if (value) {
+        moira.flags |= Moira::CPU_PROFILE;
+    } else {
+        moira.flags &= ~Moira::CPU_PROFILE;
+    }
+}
+
+void
+Profiler::record()
+{
+    u32 pc = moira.reg.pc0 & 0xFFFFFF;
+    ProfBucket &bucket = buckets[pc >> bucketBits];
+
+    bucket.cycles += (u64)(moira.clock - lastClock);
+    bucket.samples++;
+    bucket.pc = pc;
+
+    lastClock = moira.clock;
+    countdown = interval;
+}
+
+u64
+Profiler::totalCycles() const
+{
+    u64 result = 0;
+
+    if (buckets) {
+        for (long i = 0; i < bucketCount; i++) result += buckets[i].cycles;
+    }
+    return result;
+}
+
+std::vector<long>
+Profiler::sortedBuckets() const
+{
+    std::vector<long> result;
+
+    if (buckets) {
+        for (long i = 0; i < bucketCount; i++) {
+            if (buckets[i].samples) result.push_back(i);
+        }
+    }
+    std::sort(result.begin(), result.end(), [this](long a, long b) {
+        return buckets[a].cycles > buckets[b].cycles;
+    });
+
+    return result;
+}
+
+string
+Profiler::symbolize(const ProfBucket &bucket)
+{
+    char addr[16], instr[128];
+
+    moira.disassemblePC(bucket.pc, addr);
+    moira.disassemble(bucket.pc, instr);
+
+    return string(addr) + " " + instr;
+}
+
+void
+Profiler::dumpHotspots(std::ostream& os, long count)
+{
+    auto sorted = sortedBuckets();
+    u64 total = std::max(totalCycles(), 1ULL);
+
+    os << "Samples: " << std::dec;
+    os << (sorted.empty() ? 0 : interval) << " instruction interval, ";
+    os << total << " cycles" << std::endl;
+
+    for (long i = 0; i < count && i < (long)sorted.size(); i++) {
+
+        auto &bucket = buckets[sorted[i]];
+        char pct[16];
+
+        snprintf(pct, sizeof(pct), "%6.2f%%", 100.0 * bucket.cycles / total);
+        os << pct << "  " << std::setfill(' ') << std::setw(12) << bucket.cycles;
+        os << "  " << symbolize(bucket) << std::endl;
+    }
+}
+
+void
+Profiler::exportFolded(std::ostream& os)
+{
+    /* Each line has the format "<frame> <weight>" as understood by
+     * flamegraph.pl, speedscope and pprof's folded-stack importer. Since we
+     * only sample the program counter, every stack consists of a single frame.
+     * Semicolons are reserved as frame separators and must not appear inside
+     * the label.
+     */
+    for (auto i : sortedBuckets()) {
+
+        auto label = symbolize(buckets[i]);
+        std::replace(label.begin(), label.end(), ';', ',');
+        os << label << " " << std::dec << buckets[i].cycles << std::endl;
+    }
+}
+
+
+//
+// Coverage
+//
+
+void
+Coverage::enable()
+{
+    if (!bitmap) {
+        bitmap = new u8[bitmapSize];
+        clear();
+    }
+
+    enabled = true;
+    setNeedsCheck(true);
+}
+
+void
+Coverage::disable()
+{
+    enabled = false;
+    setNeedsCheck(false);
+}
+
+void
+Coverage::clear()
+{
+    if (bitmap) memset(bitmap, 0, bitmapSize);
+}
+
+void
+Coverage::setNeedsCheck(bool value)
+{
+    if (value) {
+        moira.flags |= Moira::CPU_COVERAGE;
+    } else {
+        moira.flags &= ~Moira::CPU_COVERAGE;
+    }
+}
+
+bool
+Coverage::isCovered(u32 addr) const
+{
+    return bitmap && (bitmap[(addr & 0xFFFFFF) >> 4] & (1 << ((addr >> 1) & 7)));
+}
+
+long
+Coverage::coveredWords() const
+{
+    long result = 0;
+
+    if (bitmap) {
+        for (long i = 0; i < bitmapSize; i++) result += __builtin_popcount(bitmap[i]);
+    }
+    return result;
+}
+
+void
+Coverage::diff(const u8 *other, std::ostream& os, long maxRanges) const
+{
+    long added = 0, removed = 0, ranges = 0;
+    u32 start = 0;
+    int state = 0;
+
+    auto flush = [&](u32 end) {
+        if (state && ranges++ < maxRanges) {
+            char line[64];
+            snprintf(line, sizeof(line), "%c %06X - %06X",
+                     state > 0 ? '+' : '-', start, end - 1);
+            os << line << std::endl;
+        }
+    };
+
+    for (u32 addr = 0; addr < (1 << 24); addr += 2) {
+
+        bool now = isCovered(addr);
+        bool before = other[addr >> 4] & (1 << ((addr >> 1) & 7));
+        int current = now == before ? 0 : now ? 1 : -1;
+
+        if (current > 0) added++;
+        if (current < 0) removed++;
+
+        if (current != state) {
+            flush(addr);
+            start = addr;
+            state = current;
+        }
+    }
+    flush(1 << 24);
+
+    if (ranges > maxRanges) os << "(" << ranges - maxRanges << " more ranges)" << std::endl;
+    os << std::dec << added << " words newly executed, ";
+    os << removed << " words no longer executed" << std::endl;
+}
+
+
+//
+// Tracer
+//
+
+bool
+Tracer::start(const string &path)
+{
+    stop();
+
+    if (!writer.open(path)) return false;
+
+    TraceHeader header = { {'V','A','T','R'}, version, 0 };
+    if (registers) header.flags |= withRegisters;
+    writer.write(header);
+
+    setNeedsCheck(true);
+    return true;
+}
+
+void
+Tracer::stop()
+{
+    setNeedsCheck(false);
+    writer.close();
+}
+
+void
+Tracer::setNeedsCheck(bool value)
+{
+    if (value) {
+        moira.flags |= Moira::CPU_STREAM_INSTRUCTION;
+    } else {
+        moira.flags &= ~Moira::CPU_STREAM_INSTRUCTION;
+    }
+}
+
+void
+Tracer::record()
+{
+    TraceRecord rec;
+    u32 pc = moira.reg.pc0;
+
+    rec.clock = moira.clock;
+    rec.pc = pc;
+    rec.sr = moira.getSR();
+    rec.words[0] = moira.queue.ird;
+    rec.words[1] = moira.queue.irc;
+    rec.words[2] = moira.read16Dasm(pc + 4);
+    rec.words[3] = moira.read16Dasm(pc + 6);
+    rec.words[4] = moira.read16Dasm(pc + 8);
+
+    if (registers) {
+
+        u8 data[sizeof(TraceRecord) + sizeof(moira.reg.r)];
+        memcpy(data, &rec, sizeof(rec));
+        memcpy(data + sizeof(rec), moira.reg.r, sizeof(moira.reg.r));
+        writer.write(data, sizeof(data));
+
+    } else {
+
+        writer.write(rec);
+    }
+}
+
+bool
+Tracer::convert(const string &path, std::ostream& os)
+{
+    FILE *file = fopen(path.c_str(), "rb");
+    if (!file) return false;
+
+    TraceHeader header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        memcmp(header.magic, "VATR", 4) != 0 || header.version != version) {
+
+        fclose(file);
+        return false;
+    }
+
+    TraceRecord rec;
+    u32 regs[16];
+    char pc[16], sr[32], instr[128], line[256];
+
+    while (fread(&rec, sizeof(rec), 1, file) == 1) {
+
+        if (header.flags & withRegisters) {
+            if (fread(regs, sizeof(regs), 1, file) != 1) break;
+        }
+
+        StatusRegister status;
+        status.t = (rec.sr >> 15) & 1;
+        status.s = (rec.sr >> 13) & 1;
+        status.ipl = (rec.sr >> 8) & 7;
+        status.x = (rec.sr >> 4) & 1;
+        status.n = (rec.sr >> 3) & 1;
+        status.z = (rec.sr >> 2) & 1;
+        status.v = (rec.sr >> 1) & 1;
+        status.c = (rec.sr >> 0) & 1;
+
+        moira.disassemblePC(rec.pc, pc);
+        moira.disassembleSR(status, sr);
+        moira.disassemble(rec.pc, rec.words, 5, instr);
+
+        snprintf(line, sizeof(line), "%12lld  %s  %s  %s",
+                 (long long)rec.clock, pc, sr, instr);
+        os << line << std::endl;
+
+        if (header.flags & withRegisters) {
+
+            for (int i = 0; i < 16; i++) {
+                snprintf(line, sizeof(line), "%s%c%d=%08X",
+                         i % 8 ? " " : "              ", i < 8 ? 'D' : 'A', i % 8, regs[i]);
+                os << line;
+                if (i % 8 == 7) os << std::endl;
+            }
+        }
+    }
+
+    fclose(file);
+    return true;
+}
+
+
+//
+// Debugger
+//
+
 void
 Debugger::reset()
 {
     breakpoints.setNeedsCheck(breakpoints.elements() != 0);
     watchpoints.setNeedsCheck(watchpoints.elements() != 0);
+    profiler.setNeedsCheck(profiler.isEnabled());
+    coverage.setNeedsCheck(coverage.isEnabled());
+    tracer.setNeedsCheck(tracer.isRunning());
 }
 
 void
@@ -9,6 +9,9 @@
 
 #pragma once
 
+#include "TraceWriter.h"
+#include <unordered_map>
+
 namespace moira {
 
 // Base structure for a single breakpoint or watchpoint
@@ -56,6 +59,21 @@ protected:
     // Number of currently stored guards
     long count = 0;
 
+    /* Lookup accelerators. The page filter is a bitmap with one bit per
+     * 4 KB page (the 24-bit address space maps onto it one-to-one, larger
+     * addresses wrap around). A cleared bit guarantees that no guard is set
+     * inside the page, which makes the common no-hit case a single bit test.
+     * If the bit is set, the index is consulted to find the guard in O(1).
+     * Both structures are updated incrementally when a guard is added or
+     * removed. The page counters keep track of the number of guards in each
+     * page to decide when a filter bit can be cleared again.
+     */
+    static const int pageBits = 12;
+    static const int filterSize = 4096;
+    u64 pageFilter[filterSize / 64] = { };
+    u32 pageCount[filterSize] = { };
+    std::unordered_map<u32, long> index;
+
     // Indicates if guard checking is necessary
     virtual void setNeedsCheck(bool value) = 0;
 
@@ -91,7 +109,7 @@ public:
     void removeAt(u32 addr);
 
     void remove(long nr);
-    void removeAll() { count = 0; setNeedsCheck(false); }
+    void removeAll() { count = 0; updateIndex(); setNeedsCheck(false); }
 
     void replace(long nr, u32 addr);
 
@@ -116,6 +134,19 @@ public:
 
 private:
 
+    // Checks if the page filter marks the page containing the address
+    bool mayHit(u32 addr) const {
+        u32 bit = (addr >> pageBits) & (filterSize - 1);
+        return pageFilter[bit >> 6] & (1ULL << (bit & 63));
+    }
+
+    // Adds a guard to or removes a guard from the lookup accelerators
+    void indexGuard(long nr);
+    void unindexGuard(long nr);
+
+    // Rebuilds the page filter and the address index
+    void updateIndex();
+
     bool eval(u32 addr, Size S = Byte);
 };
 
@@ -135,6 +166,306 @@ public:
     void setNeedsCheck(bool value) override;
 };
 
+// Statistics record of the profiler
+struct ProfBucket {
+
+    // Cycles attributed to this bucket
+    u64 cycles;
+
+    // Number of samples taken inside this bucket
+    u32 samples;
+
+    // Most recently sampled instruction address (used for symbolization)
+    u32 pc;
+};
+
+// PC-sampling profiler
+class Profiler {
+
+    friend class Debugger;
+
+public:
+
+    // Each bucket covers 2^bucketBits bytes of the 24-bit address space
+    static const int bucketBits = 6;
+    static const long bucketCount = 1 << (24 - bucketBits);
+
+protected:
+
+    // Reference to the connected CPU
+    class Moira &moira;
+
+    // The histogram (allocated when the profiler is enabled for the first time)
+    ProfBucket *buckets = nullptr;
+
+    // Number of executed instructions between two samples
+    long interval = 64;
+
+    // Number of instructions to go until the next sample is taken
+    long countdown = 64;
+
+    // CPU clock at the time the most recent sample was taken
+    i64 lastClock = 0;
+
+    // Indicates if the profiler is running
+    bool enabled = false;
+
+
+    //
+    // Constructing
+    //
+
+public:
+
+    Profiler(Moira& ref) : moira(ref) { }
+    ~Profiler() { delete [] buckets; }
+
+    
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isEnabled() const { return enabled; }
+    void enable();
+    void disable();
+
+    long getInterval() const { return interval; }
+    void setInterval(long value);
+
+    // Deletes all recorded samples
+    void clear();
+
+    // Sets or clears the CPU flag that activates the profiler
+    void setNeedsCheck(bool value);
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Called by the CPU before an instruction is executed
+    void sample() { if (--countdown == 0) record(); }
+
+private:
+
+    // Attributes the elapsed cycles to the bucket of the current instruction
+    void record();
+
+
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Returns the total number of cycles recorded
+    u64 totalCycles() const;
+
+    // Prints the hottest buckets in descending order
+    void dumpHotspots(std::ostream& os, long count = 20);
+
+    // Writes all non-empty buckets in folded-stack format
+    void exportFolded(std::ostream& os);
+
+private:
+
+    // Returns the indices of all non-empty buckets sorted by cycles
+    std::vector<long> sortedBuckets() const;
+
+    // Returns the symbolized label of a bucket
+    string symbolize(const ProfBucket &bucket);
+};
+
+// Code coverage recorder
+class Coverage {
+
+public:
+
+    // Size of the bitmap in bytes (one bit per word of the 24-bit space)
+    static const long bitmapSize = (1 << 24) / 16;
+
+protected:
+
+    // Reference to the connected CPU
+    class Moira &moira;
+
+    // The bitmap (allocated when coverage is enabled for the first time)
+    u8 *bitmap = nullptr;
+
+    // Indicates if coverage recording is active
+    bool enabled = false;
+
+
+    //
+    // Constructing
+    //
+
+public:
+
+    Coverage(Moira& ref) : moira(ref) { }
+    ~Coverage() { delete [] bitmap; }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    bool isEnabled() const { return enabled; }
+    void enable();
+    void disable();
+
+    // Marks all words as unexecuted
+    void clear();
+
+    // Sets or clears the CPU flag that activates coverage recording
+    void setNeedsCheck(bool value);
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Marks the word at the provided address as executed
+    void record(u32 addr) {
+        bitmap[(addr & 0xFFFFFF) >> 4] |= (u8)(1 << ((addr >> 1) & 7));
+    }
+
+    // Returns true if an instruction has been executed at this address
+    bool isCovered(u32 addr) const;
+
+
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Returns the number of executed words
+    long coveredWords() const;
+
+    // Provides access to the raw bitmap (nullptr if never enabled)
+    const u8 *getBitmap() const { return bitmap; }
+
+    /* Compares the bitmap with a previously saved one. Address ranges that
+     * have been executed in only one of both runs are listed, with "+"
+     * marking ranges which are covered now and "-" marking ranges which had
+     * been covered before. At most maxRanges ranges are printed.
+     */
+    void diff(const u8 *other, std::ostream& os, long maxRanges = 32) const;
+};
+
+// Header of a binary instruction trace file
+struct TraceHeader {
+
+    // File identifier ("VATR")
+    char magic[4];
+
+    // Format version
+    u16 version;
+
+    // Bit 0 is set if each record is followed by the register contents
+    u16 flags;
+};
+
+// A single entry of a binary instruction trace
+struct TraceRecord {
+
+    // CPU clock at the beginning of the instruction
+    i64 clock;
+
+    // Instruction address
+    u32 pc;
+
+    // Status register
+    u16 sr;
+
+    // Opcode and extension words (the longest 68000 instruction has 5 words)
+    u16 words[5];
+};
+
+// Streaming instruction tracer
+class Tracer {
+
+public:
+
+    static const u16 version = 1;
+    static const u16 withRegisters = 1;
+
+protected:
+
+    // Reference to the connected CPU
+    class Moira &moira;
+
+    // Writes the trace into a file without blocking the emulator thread
+    util::TraceWriter writer;
+
+    // Indicates if the register contents are recorded, too
+    bool registers = false;
+
+
+    //
+    // Constructing
+    //
+
+public:
+
+    Tracer(Moira& ref) : moira(ref) { }
+
+
+    //
+    // Controlling
+    //
+
+public:
+
+    // Selects whether the register contents are recorded, too
+    bool getRecordRegisters() const { return registers; }
+    void setRecordRegisters(bool value) { if (!isRunning()) registers = value; }
+
+    // Starts recording into the specified file
+    bool start(const string &path);
+
+    // Stops recording and closes the trace file
+    void stop();
+
+    bool isRunning() const { return writer.isOpen(); }
+
+    // Sets or clears the CPU flag that activates the tracer
+    void setNeedsCheck(bool value);
+
+    // Returns the number of written or discarded bytes
+    u64 bytesWritten() const { return writer.bytesWritten(); }
+    u64 bytesDropped() const { return writer.bytesDropped(); }
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    // Records the instruction that is about to be executed
+    void record();
+
+
+    //
+    // Analyzing
+    //
+
+public:
+
+    // Translates a binary trace file into a textual listing
+    bool convert(const string &path, std::ostream& os);
+};
+
 class Debugger {
 
 public:
@@ -148,6 +479,15 @@ public:
     // Watchpoint storage
     Watchpoints watchpoints = Watchpoints(moira);
 
+    // PC-sampling profiler
+    Profiler profiler = Profiler(moira);
+
+    // Code coverage recorder
+    Coverage coverage = Coverage(moira);
+
+    // Streaming instruction tracer
+    Tracer tracer = Tracer(moira);
+
 private:
 
     /* Soft breakpoint for implementing single-stepping.
@@ -29,6 +29,10 @@ Denise::Denise(Amiga& ref) : AmigaComponent(ref)
     config.clxSprSpr = true;
     config.clxSprPlf = true;
     config.clxPlfPlf = true;
+
+    #ifdef FORCE_DENISE_REVISION
+    config.revision = FORCE_DENISE_REVISION;
+    #endif
     
     memset(spriteInfo, 0, sizeof(spriteInfo));
     memset(latchedSpriteInfo, 0, sizeof(latchedSpriteInfo));
@@ -71,6 +75,11 @@ Denise::setConfigItem(Option option, long value)
             
         case OPT_DENISE_REVISION:
             
+            #ifdef FORCE_DENISE_REVISION
+            value = FORCE_DENISE_REVISION;
+            warn("Overriding Denise revision: %ld\n", value);
+            #endif
+            
             if (!DeniseRevisionEnum::isValid(value)) {
                 throw ConfigArgError(DeniseRevisionEnum::keyList());
             }
@@ -615,6 +624,11 @@ Denise::translateDPF(Pixel from, Pixel to, PFState &state)
 void
 Denise::drawSprites()
 {
+    // Quick exit if no sprite has been armed or written to in this line
+    if (!wasArmed &&
+        sprChanges[0].isEmpty() && sprChanges[1].isEmpty() &&
+        sprChanges[2].isEmpty() && sprChanges[3].isEmpty()) return;
+
     if (wasArmed) {
         
         if (wasArmed & 0b11000000) drawSpritePair<3>();
@@ -907,7 +921,7 @@ Denise::drawAttachedSpritePixelPair(Pixel hpos)
 void
 Denise::updateBorderColor()
 {
-    if (config.revision != DENISE_OCS && ecsena() && BRDRBLNK()) {
+    if (hasBorderBlank() && ecsena() && BRDRBLNK()) {
         borderColor = 64; // Pure black
     } else {
         borderColor = 0;  // Background color
@@ -284,6 +284,14 @@ public:
     long getConfigItem(Option option) const;
     bool setConfigItem(Option option, long value) override;
     
+#ifdef FORCE_DENISE_REVISION
+    bool isECS() const { return FORCE_DENISE_REVISION == DENISE_ECS; }
+    bool hasBorderBlank() const { return FORCE_DENISE_REVISION != DENISE_OCS; }
+#else
+    bool isECS() const { return config.revision == DENISE_ECS; }
+    bool hasBorderBlank() const { return config.revision != DENISE_OCS; }
+#endif
+    
     
     //
     // Analyzing
@@ -59,7 +59,7 @@ Denise::peekDENISEID()
 {
     u16 result;
 
-    if (config.revision == DENISE_ECS) {
+    if (isECS()) {
         result = 0xFFFC;                           // ECS
     } else {
         result = mem.peekCustomFaulty16(0xDFF07C); // OCS
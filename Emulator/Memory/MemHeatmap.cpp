@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "MemHeatmap.h"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <vector>
+
+MemHeatmap::MemHeatmap()
+{
+    clear();
+}
+
+void
+MemHeatmap::clear()
+{
+    memset(&current, 0, sizeof(current));
+    memset(totals, 0, sizeof(totals));
+    frames = 0;
+}
+
+void
+MemHeatmap::endFrame(i64 nr)
+{
+    current.frame = nr;
+    if (writer.isOpen()) writer.write(current);
+
+    for (isize a = 0; a < 2; a++) {
+        for (isize rw = 0; rw < 2; rw++) {
+            for (isize p = 0; p < 256; p++) {
+                totals[a][rw][p] += current.counts[a][rw][p];
+            }
+        }
+    }
+    frames++;
+
+    memset(&current, 0, sizeof(current));
+}
+
+bool
+MemHeatmap::start(const string &path)
+{
+    stop();
+
+    if (!writer.open(path)) return false;
+
+    HeatmapHeader header = { {'V','A','H','M'}, version, 256 };
+    writer.write(header);
+
+    return true;
+}
+
+void
+MemHeatmap::stop()
+{
+    writer.close();
+}
+
+void
+MemHeatmap::dump(std::ostream& os, isize count) const
+{
+    auto sum = [&](isize p) {
+        return totals[0][0][p] + totals[0][1][p] + totals[1][0][p] + totals[1][1][p];
+    };
+
+    // Sort all pages with at least one access by their total access count
+    std::vector<isize> pages;
+    for (isize p = 0; p < 256; p++) if (sum(p)) pages.push_back(p);
+    std::stable_sort(pages.begin(), pages.end(), [&](isize a, isize b) {
+        return sum(a) > sum(b);
+    });
+
+    os << "Frames: " << std::dec << frames << std::endl;
+    os << "Page      CPU reads   CPU writes  Agnus reads Agnus writes" << std::endl;
+
+    for (isize i = 0; i < count && i < (isize)pages.size(); i++) {
+
+        auto p = pages[i];
+
+        os << std::hex << std::setfill('0') << std::setw(2) << p << "xxxx";
+        os << std::dec << std::setfill(' ');
+        os << std::setw(13) << totals[ACCESSOR_CPU][0][p];
+        os << std::setw(13) << totals[ACCESSOR_CPU][1][p];
+        os << std::setw(13) << totals[ACCESSOR_AGNUS][0][p];
+        os << std::setw(13) << totals[ACCESSOR_AGNUS][1][p] << std::endl;
+    }
+}
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "MemoryTypes.h"
+#include "TraceWriter.h"
+#include <ostream>
+
+/* Layout of a heatmap file:
+ *
+ *     HeatmapHeader
+ *     HeatmapFrame (frame 1)
+ *     HeatmapFrame (frame 2)
+ *     ...
+ *
+ * Each HeatmapFrame stores the number of memory accesses that have happened
+ * in a single frame, broken down by accessor (CPU, Agnus), direction (read,
+ * write), and 64 KB page. All values are stored in host byte order.
+ */
+struct HeatmapHeader
+{
+    char magic[4];
+    u16 version;
+    u16 pages;
+};
+
+struct HeatmapFrame
+{
+    i64 frame;
+    u32 counts[2][2][256];
+};
+
+/* The memory heatmap collects per-frame access statistics. Counting is only
+ * performed if MEM_HEATMAP is set in config.h. Otherwise, all calls into the
+ * collector are optimized away by the compiler.
+ */
+class MemHeatmap
+{
+public:
+
+    static constexpr u16 version = 1;
+
+private:
+
+    // Access counters of the current frame
+    HeatmapFrame current;
+
+    // Accumulated access counters
+    u64 totals[2][2][256];
+
+    // Number of frames the totals have been accumulated over
+    i64 frames = 0;
+
+    // Output stream
+    util::TraceWriter writer = util::TraceWriter(1024 * 1024);
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    MemHeatmap();
+
+    // Resets all counters
+    void clear();
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    template <Accessor A> void recordRead(u32 addr) {
+        current.counts[A][0][(addr >> 16) & 0xFF]++;
+    }
+    template <Accessor A> void recordWrite(u32 addr) {
+        current.counts[A][1][(addr >> 16) & 0xFF]++;
+    }
+
+    // Finishes the current frame (called in the VSYNC handler)
+    void endFrame(i64 nr);
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Starts or stops streaming frame records into a file
+    bool start(const string &path);
+    void stop();
+    bool isRunning() const { return writer.isOpen(); }
+
+    // Returns the number of written or discarded bytes
+    u64 bytesWritten() const { return writer.bytesWritten(); }
+    u64 bytesDropped() const { return writer.bytesDropped(); }
+
+    // Prints the pages with the highest number of accesses
+    void dump(std::ostream& os, isize count) const;
+};
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "MemTracer.h"
+#include <algorithm>
+#include <iomanip>
+
+void
+MemTracer::setRange(u32 lo, u32 hi)
+{
+    lo &= 0xFFFFFF;
+    hi &= 0xFFFFFF;
+    
+    this->lo = std::min(lo, hi);
+    this->hi = std::max(lo, hi);
+}
+
+void
+MemTracer::setAccessor(Accessor a, bool value)
+{
+    assert(AccessorEnum::isValid(a));
+    
+    if (value) {
+        accessors |= (1 << a);
+    } else {
+        accessors &= ~(1 << a);
+    }
+}
+
+bool
+MemTracer::start(const string &path)
+{
+    stop();
+
+    if (!writer.open(path)) return false;
+
+    MemTraceHeader header = {
+        {'V','A','M','T'}, version, (u16)sizeof(MemTraceRecord) };
+    writer.write(header);
+
+    records = 0;
+    active = true;
+    return true;
+}
+
+void
+MemTracer::stop()
+{
+    active = false;
+    writer.close();
+}
+
+void
+MemTracer::dump(std::ostream& os) const
+{
+    os << "Running: " << (isRunning() ? "yes" : "no") << std::endl;
+    os << "  Range: " << std::hex << std::setfill('0');
+    os << std::setw(6) << lo << " - " << std::setw(6) << hi << std::endl;
+    os << std::dec << std::setfill(' ');
+    os << "    CPU: " << (getAccessor(ACCESSOR_CPU) ? "yes" : "no") << std::endl;
+    os << "  Agnus: " << (getAccessor(ACCESSOR_AGNUS) ? "yes" : "no") << std::endl;
+    os << "Records: " << records << std::endl;
+    os << "Written: " << writer.bytesWritten() << " bytes" << std::endl;
+    os << "Dropped: " << writer.bytesDropped() << " bytes" << std::endl;
+}
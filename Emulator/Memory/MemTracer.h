@@ -0,0 +1,121 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "MemoryTypes.h"
+#include "TraceWriter.h"
+#include <ostream>
+
+/* Layout of a memory trace file:
+ *
+ *     MemTraceHeader
+ *     MemTraceRecord (access 1)
+ *     MemTraceRecord (access 2)
+ *     ...
+ *
+ * Each record describes a single bus transaction. Cycles are measured in
+ * master clock cycles. All values are stored in host byte order.
+ */
+struct MemTraceHeader
+{
+    char magic[4];
+    u16 version;
+    u16 recordSize;
+};
+
+struct MemTraceRecord
+{
+    i64 cycle;
+    u32 addr;
+    u16 value;
+    u8 accessor;
+    u8 flags;
+};
+
+/* The memory tracer streams all bus transactions that pass the address and
+ * accessor filters into a file. Records are handed over to a background
+ * thread via a lock-free ring buffer. If the writer falls behind, records
+ * are dropped instead of stalling the emulator.
+ */
+class MemTracer
+{
+public:
+
+    static constexpr u16 version = 1;
+
+    // Record flags
+    static constexpr u8 WRITE = 0b01;
+    static constexpr u8 WORD  = 0b10;
+
+private:
+
+    // Indicates whether the tracer is recording
+    bool active = false;
+
+    // Address filter (inclusive)
+    u32 lo = 0;
+    u32 hi = 0xFFFFFF;
+
+    // Accessor filter (one bit per accessor)
+    u8 accessors = (1 << ACCESSOR_CPU) | (1 << ACCESSOR_AGNUS);
+
+    // Number of recorded transactions
+    u64 records = 0;
+
+    // Output stream
+    util::TraceWriter writer;
+
+
+    //
+    // Configuring
+    //
+
+public:
+
+    void setRange(u32 lo, u32 hi);
+    u32 getRangeLo() const { return lo; }
+    u32 getRangeHi() const { return hi; }
+
+    void setAccessor(Accessor a, bool value);
+    bool getAccessor(Accessor a) const { return accessors & (1 << a); }
+
+
+    //
+    // Recording
+    //
+
+public:
+
+    bool isActive() const { return active; }
+
+    template <Accessor A> void record(i64 cycle, u32 addr, u16 value, u8 flags) {
+        
+        if (!(accessors & (1 << A))) return;
+        if ((addr & 0xFFFFFF) - lo > hi - lo) return;
+        
+        writer.write(MemTraceRecord { cycle, addr & 0xFFFFFF, value, A, flags });
+        records++;
+    }
+
+
+    //
+    // Exporting
+    //
+
+public:
+
+    // Starts or stops streaming records into a file
+    bool start(const string &path);
+    void stop();
+    bool isRunning() const { return writer.isOpen(); }
+
+    // Prints some information about the current state
+    void dump(std::ostream& os) const;
+};
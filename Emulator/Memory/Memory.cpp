@@ -21,6 +21,8 @@
 #include "RomFile.h"
 #include "RTC.h"
 #include "ZorroManager.h"
+#include <sys/mman.h>
+#include <unistd.h>
 
 Memory::Memory(Amiga& ref) : AmigaComponent(ref)
 {
@@ -31,6 +33,8 @@ Memory::Memory(Amiga& ref) : AmigaComponent(ref)
     config.ramInitPattern = RAM_INIT_ALL_ZEROES;
     config.unmappingType  = UNMAPPED_FLOATING;
     config.extStart       = 0xE0;
+
+    initCustomTables<0>();
 }
 
 Memory::~Memory()
@@ -41,12 +45,12 @@ Memory::~Memory()
 void
 Memory::dealloc()
 {
-    if (rom) { delete[] rom; rom = nullptr; }
+    if (rom) { romImage = nullptr; rom = nullptr; }
     if (wom) { delete[] wom; wom = nullptr; }
-    if (ext) { delete[] ext; ext = nullptr; }
-    if (chip) { delete[] chip; chip = nullptr; }
-    if (slow) { delete[] slow; slow = nullptr; }
-    if (fast) { delete[] fast; fast = nullptr; }
+    if (ext) { extImage = nullptr; ext = nullptr; }
+    if (chip) { unmapLazy(chip, config.chipSize); chip = nullptr; }
+    if (slow) { unmapLazy(slow, config.slowSize); slow = nullptr; }
+    if (fast) { unmapLazy(fast, config.fastSize); fast = nullptr; }
 }
 
 void
@@ -222,13 +226,17 @@ Memory::_size()
     << config.chipSize
     << config.slowSize
     << config.fastSize;
-    
+
     counter.count += config.romSize;
     counter.count += config.womSize;
     counter.count += config.extSize;
     counter.count += config.chipSize;
     counter.count += config.slowSize;
-    counter.count += config.fastSize;
+
+    // Fast Ram is stored as a page count, followed by numbered pages
+    i32 pages = countFastPages();
+    for (i32 nr = 0; nr <= pages; nr++) counter << nr;
+    counter.count += pages * fastPageSize;
 
     return counter.count;
 }
@@ -238,6 +246,13 @@ Memory::didLoadFromBuffer(const u8 *buffer)
 {
     util::SerReader reader(buffer);
 
+    // Keep the current Roms alive to share them if the snapshot uses them, too
+    auto oldRom = romImage;
+    auto oldExt = extImage;
+
+    // Free previously allocated memory
+    dealloc();
+
     // Load memory size information
     reader
     << config.romSize
@@ -255,25 +270,54 @@ Memory::didLoadFromBuffer(const u8 *buffer)
     if (config.slowSize > KB(512)) { config.slowSize = 0; assert(false); }
     if (config.fastSize > MB(8)) { config.fastSize = 0; assert(false); }
 
-    // Free previously allocated memory
-    dealloc();
+    /* Load the Roms. The images are shared with all instances using the same
+     * Rom. Hence, the data is only duplicated if the Rom isn't in use yet.
+     */
+    if (config.romSize) {
+        romImage = RomImage::make(reader.ptr, config.romSize);
+        if (!romImage) throw VAError(ERROR_OUT_OF_MEMORY);
+        rom = romImage->data;
+        reader.ptr += config.romSize;
+    }
 
     // Allocate new memory
-    if (config.romSize) rom = new (std::nothrow) u8[config.romSize];
     if (config.womSize) wom = new (std::nothrow) u8[config.womSize];
-    if (config.extSize) ext = new (std::nothrow) u8[config.extSize];
-    if (config.chipSize) chip = new (std::nothrow) u8[config.chipSize];
-    if (config.slowSize) slow = new (std::nothrow) u8[config.slowSize];
-    if (config.fastSize) fast = new (std::nothrow) u8[config.fastSize];
+    if (config.chipSize) chip = mapLazy(config.chipSize);
+    if (config.slowSize) slow = mapLazy(config.slowSize);
+    if (config.fastSize) fast = mapLazy(config.fastSize);
 
     // Load memory contents from buffer
-    reader.copy(rom, config.romSize);
     reader.copy(wom, config.womSize);
-    reader.copy(ext, config.extSize);
+
+    if (config.extSize) {
+        extImage = RomImage::make(reader.ptr, config.extSize);
+        if (!extImage) throw VAError(ERROR_OUT_OF_MEMORY);
+        ext = extImage->data;
+        reader.ptr += config.extSize;
+    }
+
     reader.copy(chip, config.chipSize);
     reader.copy(slow, config.slowSize);
-    reader.copy(fast, config.fastSize);
 
+    // Load all stored Fast Ram pages
+    i32 pages;
+    reader << pages;
+    for (i32 i = 0; i < pages; i++) {
+
+        i32 nr;
+        reader << nr;
+
+        if (fast && nr >= 0 && (nr + 1) * fastPageSize <= config.fastSize) {
+            reader.copy(fast + nr * fastPageSize, fastPageSize);
+        } else {
+            reader.ptr += fastPageSize; assert(false);
+        }
+    }
+
+    // Memory has been reallocated. Update the host pointers
+    updateCpuPageTable();
+    genEpoch++;
+    
     return (isize)(reader.ptr - buffer);
 }
 
@@ -289,18 +333,50 @@ Memory::didSaveToBuffer(u8 *buffer) const
     << config.chipSize
     << config.slowSize
     << config.fastSize;
-    
+
     // Save memory contents
     writer.copy(rom, config.romSize);
     writer.copy(wom, config.womSize);
     writer.copy(ext, config.extSize);
     writer.copy(chip, config.chipSize);
     writer.copy(slow, config.slowSize);
-    writer.copy(fast, config.fastSize);
+
+    // Save all Fast Ram pages that contain data
+    i32 pages = countFastPages();
+    writer << pages;
+    for (i32 nr = 0; nr < config.fastSize / fastPageSize; nr++) {
+
+        if (isZeroPage(fast + nr * fastPageSize)) continue;
+
+        writer << nr;
+        writer.copy(fast + nr * fastPageSize, fastPageSize);
+    }
     
     return (isize)(writer.ptr - buffer);
 }
 
+bool
+Memory::isZeroPage(const u8 *page) const
+{
+    auto p = (const u64 *)page;
+
+    for (isize i = 0; i < fastPageSize / 8; i++) {
+        if (p[i]) return false;
+    }
+    return true;
+}
+
+i32
+Memory::countFastPages() const
+{
+    i32 result = 0;
+
+    for (isize nr = 0; nr < config.fastSize / fastPageSize; nr++) {
+        if (!isZeroPage(fast + nr * fastPageSize)) result++;
+    }
+    return result;
+}
+
 void
 Memory::_dump(Dump::Category category, std::ostream& os) const
 {
@@ -403,10 +479,12 @@ Memory::updateStats()
     stats.fastWrites.raw = 0;
     stats.kickReads.raw = 0;
     stats.kickWrites.raw = 0;
+
+    if (MEM_HEATMAP) heatmap.endFrame(agnus.frame.nr);
 }
 
 bool
-Memory::alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask)
+Memory::alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask, bool lazy)
 {
     // Check the invariants
     assert((ptr == nullptr) == (size == 0));
@@ -417,14 +495,19 @@ Memory::alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask)
     if (bytes == size) return true;
     
     // Delete previous allocation
-    if (ptr) { delete[] ptr; ptr = nullptr; size = 0; mask = 0; }
+    if (ptr) {
+        
+        if (lazy) unmapLazy(ptr, size); else delete[] ptr;
+        ptr = nullptr; size = 0; mask = 0;
+    }
     
     // Allocate memory
     if (bytes) {
         
         isize allocSize = bytes;
-        
-        if (!(ptr = new (std::nothrow) u8[allocSize])) {
+
+        ptr = lazy ? mapLazy(allocSize) : new (std::nothrow) u8[allocSize];
+        if (!ptr) {
             warn("Cannot allocate %d KB of memory\n", bytes);
             return false;
         }
@@ -441,21 +524,194 @@ Memory::alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask)
     return true;
 }
 
+void
+Memory::attach(std::shared_ptr<RomImage> image,
+               std::shared_ptr<RomImage> &slot, u8 *&ptr, i32 &size, u32 &mask)
+{
+    slot = image;
+    ptr = image ? image->data : nullptr;
+    size = image ? (i32)image->size : 0;
+    mask = image ? (u32)size - 1 : 0;
+    
+    updateMemSrcTables();
+}
+
+void
+Memory::eraseRom()
+{
+    if (rom) {
+        
+        std::vector<u8> zeroes(config.romSize);
+        attachRom(RomImage::make(zeroes.data(), config.romSize));
+    }
+}
+
+void
+Memory::eraseExt()
+{
+    if (ext) {
+        
+        std::vector<u8> zeroes(config.extSize);
+        attachExt(RomImage::make(zeroes.data(), config.extSize));
+    }
+}
+
+u8 *
+Memory::mapLazy(isize bytes)
+{
+    void *ptr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON, -1, 0);
+
+    return ptr == MAP_FAILED ? nullptr : (u8 *)ptr;
+}
+
+void
+Memory::unmapLazy(u8 *ptr, isize bytes)
+{
+    munmap(ptr, bytes);
+}
+
+/* Generator for the randomized Ram init pattern. All Ram banks are filled
+ * with a single continuous stream (Chip Ram first, followed by Slow Ram and
+ * Fast Ram). A local xorshift generator is used instead of rand() to keep the
+ * global random state untouched and to get the same pattern on all hosts.
+ * Changing the seed or the algorithm changes the power-up contents of Ram
+ * and breaks the reproducibility of recorded runs.
+ */
+struct RamPatternGenerator
+{
+    u32 state = 0x2545F491;
+
+    u8 next() {
+
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return (u8)(state >> 24);
+    }
+
+    void fill(u8 *ptr, isize bytes) {
+
+        for (isize i = 0; i < bytes; i++) ptr[i] = next();
+    }
+};
+
+// Size of the pattern files (covers the maximum size of all Ram banks)
+static constexpr isize patternFileSize = MB(16);
+
+/* Returns a file holding an init pattern for all Ram banks. The file is
+ * created on first use and shared among all emulator instances.
+ */
+static int
+patternFile(RamInitPattern pattern)
+{
+    static FILE *files[RAM_INIT_COUNT];
+    static util::ReentrantMutex lock;
+    
+    util::AutoMutex _am(lock);
+    
+    if (!files[pattern] && (files[pattern] = tmpfile())) {
+
+        std::vector<u8> buffer(patternFileSize);
+        
+        switch (pattern) {
+                
+            case RAM_INIT_RANDOMIZED:
+                
+                RamPatternGenerator().fill(buffer.data(), buffer.size());
+                break;
+                
+            case RAM_INIT_ALL_ZEROES:
+                
+                break;
+                
+            case RAM_INIT_ALL_ONES:
+                
+                std::fill(buffer.begin(), buffer.end(), 0xFF);
+                break;
+                
+            default:
+                assert(false);
+        }
+        
+        if (fwrite(buffer.data(), 1, buffer.size(), files[pattern]) != buffer.size() ||
+            fflush(files[pattern]) != 0) {
+            
+            fclose(files[pattern]);
+            files[pattern] = nullptr;
+        }
+    }
+    
+    return files[pattern] ? fileno(files[pattern]) : -1;
+}
+
+bool
+Memory::initLazy(u8 *ptr, isize bytes, RamInitPattern pattern, isize offset)
+{
+    void *result;
+    
+    if (pattern == RAM_INIT_ALL_ZEROES) {
+        
+        // A fresh anonymous mapping reads as zero
+        result = mmap(ptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANON | MAP_FIXED, -1, 0);
+        
+    } else {
+        
+        int fd = patternFile(pattern);
+        if (fd < 0 || offset + bytes > patternFileSize) return false;
+        if (offset % sysconf(_SC_PAGESIZE)) return false;
+        
+        result = mmap(ptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_FIXED, fd, (off_t)offset);
+    }
+    
+    /* Note: On failure, MAP_FIXED may have already discarded the old mapping.
+     * To stay on the safe side, we map zeroed memory as a fallback.
+     */
+    if (result == MAP_FAILED) {
+        
+        result = mmap(ptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANON | MAP_FIXED, -1, 0);
+        assert(result != MAP_FAILED);
+        return false;
+    }
+    
+    return true;
+}
+
 void
 Memory::fillRamWithInitPattern()
 {
     assert(!isRunning());
+
+    // All Ram cells are going to change. Invalidate all write generations
+    genEpoch++;
+
+    // Each bank is mapped to its own section of the continuous pattern
+    isize chipOffset = 0;
+    isize slowOffset = chipOffset + config.chipSize;
+    isize fastOffset = slowOffset + config.slowSize;
     
+    // Remap all Ram banks (this is where the pattern gets written lazily)
+    bool lazy = true;
+    if (chip) lazy &= initLazy(chip, config.chipSize, config.ramInitPattern, chipOffset);
+    if (slow) lazy &= initLazy(slow, config.slowSize, config.ramInitPattern, slowOffset);
+    if (fast) lazy &= initLazy(fast, config.fastSize, config.ramInitPattern, fastOffset);
+    if (lazy) return;
+
+    // Fall back to writing the pattern into memory
     switch (config.ramInitPattern) {
             
         case RAM_INIT_RANDOMIZED:
-
-            srand(0);
-            if (chip) for (isize i = 0; i < config.chipSize; i++) chip[i] = rand();
-            if (slow) for (isize i = 0; i < config.slowSize; i++) slow[i] = rand();
-            if (fast) for (isize i = 0; i < config.fastSize; i++) fast[i] = rand();
+        {
+            // Produces the same stream as the one stored in the pattern file
+            RamPatternGenerator generator;
+            if (chip) generator.fill(chip, config.chipSize);
+            if (slow) generator.fill(slow, config.slowSize);
+            if (fast) generator.fill(fast, config.fastSize);
             break;
-            
+        }
         case RAM_INIT_ALL_ZEROES:
 
             if (chip) memset(chip, 0x00, config.chipSize);
@@ -563,11 +819,10 @@ Memory::loadRom(RomFile *file)
     // Decrypt Rom
     file->decrypt();
 
-    // Allocate memory
-    if (!allocRom((i32)file->size)) throw VAError(ERROR_OUT_OF_MEMORY);
-    
-    // Load Rom
-    loadRom(file, rom, config.romSize);
+    // Install Rom
+    auto image = RomImage::make(file->data, file->size);
+    if (!image) throw VAError(ERROR_OUT_OF_MEMORY);
+    attachRom(image);
 
     // Add a Wom if a Boot Rom is installed instead of a Kickstart Rom
     hasBootRom() ? (void)allocWom(KB(256)) : deleteWom();
@@ -615,11 +870,10 @@ Memory::loadExt(ExtendedRomFile *file)
 {
     assert(file);
 
-    // Allocate memory
-    if (!allocExt((i32)file->size)) throw VAError(ERROR_OUT_OF_MEMORY);
-    
-    // Load Rom
-    loadRom(file, ext, config.extSize);
+    // Install Rom
+    auto image = RomImage::make(file->data, file->size);
+    if (!image) throw VAError(ERROR_OUT_OF_MEMORY);
+    attachExt(image);
 }
 
 void
@@ -656,22 +910,6 @@ Memory::loadExtFromBuffer(const u8 *buf, isize len, ErrorCode *ec)
     catch (VAError &exception) { *ec = exception.data; }
 }
  
-void
-Memory::loadRom(AmigaFile *file, u8 *target, isize length)
-{
-    if (file) {
-
-        assert(target != nullptr);
-        memset(target, 0, length);
-
-        if (file->size < length) {
-            warn("ROM is smaller than buffer\n");
-        }
-        
-        memcpy(target, file->data, std::min(file->size, length));
-    }
-}
-
 void
 Memory::saveRom(const char *path)
 {
@@ -737,6 +975,9 @@ Memory::updateMemSrcTables()
 {
     updateCpuMemSrcTable();
     updateAgnusMemSrcTable();
+
+    // The memory layout has changed. Invalidate all write generations
+    genEpoch++;
 }
 
 void
@@ -847,9 +1088,55 @@ Memory::updateCpuMemSrcTable()
             cpuMemSrc[i] = cpuMemSrc[0xF8 + i];
     }
 
+    updateCpuPageTable();
+    
     messageQueue.put(MSG_MEM_LAYOUT);
 }
 
+void
+Memory::updateCpuPageTable()
+{
+    for (isize i = 0x00; i <= 0xFF; i++) {
+
+        u32 bank = (u32)i << 16;
+
+        cpuReadPage[i] = { nullptr, 0, nullptr };
+        cpuWritePage[i] = { nullptr, 0, nullptr };
+
+        switch (cpuMemSrc[i]) {
+
+            case MEM_FAST:
+
+                assert(fast);
+                cpuReadPage[i] = { fast + (bank - FAST_RAM_STRT), 0xFFFF, &stats.fastReads.raw };
+                cpuWritePage[i] = { fast + (bank - FAST_RAM_STRT), 0xFFFF, &stats.fastWrites.raw };
+                break;
+
+            case MEM_ROM:
+            case MEM_ROM_MIRROR:
+
+                assert(rom);
+                cpuReadPage[i] = { rom + (bank & romMask), romMask & 0xFFFF, &stats.kickReads.raw };
+                break;
+
+            case MEM_WOM:
+
+                assert(wom);
+                cpuReadPage[i] = { wom + (bank & womMask), womMask & 0xFFFF, &stats.kickReads.raw };
+                break;
+
+            case MEM_EXT:
+
+                assert(ext);
+                cpuReadPage[i] = { ext + (bank & extMask), extMask & 0xFFFF, &stats.kickReads.raw };
+                break;
+
+            default:
+                break;
+        }
+    }
+}
+
 void
 Memory::updateAgnusMemSrcTable()
 {
@@ -1184,11 +1471,50 @@ Memory::spypeek16 <ACCESSOR_CPU, MEM_EXT> (u32 addr) const
     return READ_EXT_16(addr);
 }
 
+u64
+Memory::getGeneration(u32 addr) const
+{
+    addr &= 0xFFFFFF;
+
+    // Map mirrored Ram to its canonical address
+    switch (cpuMemSrc[addr >> 16]) {
+
+        case MEM_CHIP:
+        case MEM_CHIP_MIRROR:   addr &= chipMask; break;
+        case MEM_SLOW:
+        case MEM_SLOW_MIRROR:   addr = 0xC00000 + (addr & slowMask); break;
+        case MEM_WOM:           addr = 0xF80000 + (addr & womMask); break;
+        case MEM_FAST:
+        case MEM_ROM:
+        case MEM_ROM_MIRROR:
+        case MEM_EXT:           break;
+
+        default:
+            // Register banks and unmapped memory can change at any time
+            return 0;
+    }
+
+    return (u64)genEpoch << 32 | pageGen[addr >> 12];
+}
+
 template<> u8
 Memory::peek8 <ACCESSOR_CPU> (u32 addr)
 {
     u8 result;
-        
+
+    if (MEM_HEATMAP) heatmap.recordRead<ACCESSOR_CPU>(addr);
+
+    // Take the fast path if the bank can be accessed directly
+    auto &page = cpuReadPage[(addr & 0xFFFFFF) >> 16];
+    if (page.base) {
+        (*page.counter)++;
+        result = R8BE_ALIGNED(page.base + (addr & page.mask));
+        if (tracer.isActive()) {
+            tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, result, 0);
+        }
+        return result;
+    }
+    
     switch (cpuMemSrc[(addr & 0xFFFFFF) >> 16]) {
             
         case MEM_NONE:          result = peek8 <ACCESSOR_CPU, MEM_NONE>     (addr); break;
@@ -1210,7 +1536,10 @@ Memory::peek8 <ACCESSOR_CPU> (u32 addr)
             
         default: assert(false); return 0;
     }
-        
+
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, result, 0);
+    }
     return result;
 }
 
@@ -1220,6 +1549,20 @@ Memory::peek16 <ACCESSOR_CPU> (u32 addr)
     u16 result;
     
     assert(IS_EVEN(addr));
+
+    if (MEM_HEATMAP) heatmap.recordRead<ACCESSOR_CPU>(addr);
+
+    // Take the fast path if the bank can be accessed directly
+    auto &page = cpuReadPage[(addr & 0xFFFFFF) >> 16];
+    if (page.base) {
+        (*page.counter)++;
+        result = R16BE_ALIGNED(page.base + (addr & page.mask));
+        if (tracer.isActive()) {
+            tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, result,
+                                        MemTracer::WORD);
+        }
+        return result;
+    }
     
     switch (cpuMemSrc[(addr & 0xFFFFFF) >> 16]) {
             
@@ -1242,7 +1585,11 @@ Memory::peek16 <ACCESSOR_CPU> (u32 addr)
             
         default: assert(false); return 0;
     }
-        
+
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, result,
+                                    MemTracer::WORD);
+    }
     return result;
 }
 
@@ -1334,6 +1681,8 @@ Memory::peek16 <ACCESSOR_AGNUS> (u32 addr)
     assert(IS_EVEN(addr));
     addr &= agnus.ptrMask;
 
+    if (MEM_HEATMAP) heatmap.recordRead<ACCESSOR_AGNUS>(addr);
+
     switch (agnusMemSrc[addr >> 16]) {
             
         case MEM_NONE:        result = peek16 <ACCESSOR_AGNUS, MEM_NONE> (addr); break;
@@ -1342,7 +1691,11 @@ Memory::peek16 <ACCESSOR_AGNUS> (u32 addr)
             
         default: assert(false); return 0;
     }
-        
+
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_AGNUS>(agnus.clock, addr, result,
+                                      MemTracer::WORD);
+    }
     return result;
 }
 
@@ -1607,6 +1960,21 @@ Memory::poke16 <ACCESSOR_CPU, MEM_EXT> (u32 addr, u16 value)
 template<> void
 Memory::poke8 <ACCESSOR_CPU> (u32 addr, u8 value)
 {
+    if (MEM_HEATMAP) heatmap.recordWrite<ACCESSOR_CPU>(addr);
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, value,
+                                    MemTracer::WRITE);
+    }
+
+    // Take the fast path if the bank can be accessed directly
+    auto &page = cpuWritePage[(addr & 0xFFFFFF) >> 16];
+    if (page.base) {
+        (*page.counter)++;
+        W8BE_ALIGNED(page.base + (addr & page.mask), value);
+        TOUCH_PAGE(addr);
+        return;
+    }
+    
     switch (cpuMemSrc[(addr & 0xFFFFFF) >> 16]) {
             
         case MEM_NONE:          poke8 <ACCESSOR_CPU, MEM_NONE>     (addr, value); return;
@@ -1651,6 +2019,21 @@ Memory::poke16 <ACCESSOR_CPU> (u32 addr, u16 value)
         if (value == 0x302) amiga.signalStop();
     }
     */
+
+    if (MEM_HEATMAP) heatmap.recordWrite<ACCESSOR_CPU>(addr);
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_CPU>(cpu.getMasterClock(), addr, value,
+                                    MemTracer::WRITE | MemTracer::WORD);
+    }
+
+    // Take the fast path if the bank can be accessed directly
+    auto &page = cpuWritePage[(addr & 0xFFFFFF) >> 16];
+    if (page.base) {
+        (*page.counter)++;
+        W16BE_ALIGNED(page.base + (addr & page.mask), value);
+        TOUCH_PAGE(addr);
+        return;
+    }
     
     switch (cpuMemSrc[(addr & 0xFFFFFF) >> 16]) {
             
@@ -1711,6 +2094,12 @@ Memory::poke16 <ACCESSOR_AGNUS> (u32 addr, u16 value)
 {
     assert(IS_EVEN(addr));
     addr &= agnus.ptrMask;
+
+    if (MEM_HEATMAP) heatmap.recordWrite<ACCESSOR_AGNUS>(addr);
+    if (tracer.isActive()) {
+        tracer.record<ACCESSOR_AGNUS>(agnus.clock, addr, value,
+                                      MemTracer::WRITE | MemTracer::WORD);
+    }
     
     switch (agnusMemSrc[addr >> 16]) {
             
@@ -1902,50 +2291,9 @@ Memory::pokeRTC16(u32 addr, u16 value)
 u16
 Memory::peekCustom16(u32 addr)
 {
-    u32 result;
-
     assert(IS_EVEN(addr));
 
-    switch ((addr >> 1) & 0xFF) {
-            
-        case 0x000 >> 1: // BLTDDAT
-            result = 0xFFFF; break;
-        case 0x002 >> 1: // DMACONR
-            result = agnus.peekDMACONR(); break;
-        case 0x004 >> 1: // VPOSR
-            result = agnus.peekVPOSR(); break;
-        case 0x006 >> 1: // VHPOSR
-            result = agnus.peekVHPOSR(); break;
-        case 0x008 >> 1: // DSKDATR
-            result = paula.diskController.peekDSKDATR(); break;
-        case 0x00A >> 1: // JOY0DAT
-            result = denise.peekJOY0DATR(); break;
-        case 0x00C >> 1: // JOY1DAT
-            result = denise.peekJOY1DATR(); break;
-        case 0x00E >> 1: // CLXDAT
-            result = denise.peekCLXDAT(); break;
-        case 0x010 >> 1: // ADKCONR
-            result = paula.peekADKCONR(); break;
-        case 0x012 >> 1: // POT0DAT
-            result = paula.peekPOTxDAT<0>(); break;
-        case 0x014 >> 1: // POT1DAT
-            result = paula.peekPOTxDAT<1>(); break;
-        case 0x016 >> 1: // POTGOR
-            result = paula.peekPOTGOR(); break;
-        case 0x018 >> 1: // SERDATR
-            result = uart.peekSERDATR(); break;
-        case 0x01A >> 1: // DSKBYTR
-            result = diskController.peekDSKBYTR(); break;
-        case 0x01C >> 1: // INTENAR
-            result = paula.peekINTENAR(); break;
-        case 0x01E >> 1: // INTREQR
-            result = paula.peekINTREQR(); break;
-        case 0x07C >> 1: // DENISEID
-            result = denise.peekDENISEID(); break;
-        default:
-            result = peekCustomFaulty16(addr);
-
-    }
+    u16 result = (this->*customPeekTable[(addr >> 1) & 0xFF])(addr);
 
     trace(OCSREG_DEBUG, "peekCustom16(%X [%s]) = %X\n", addr, regName(addr), result);
 
@@ -2003,7 +2351,62 @@ Memory::pokeCustom16(u32 addr, u16 value)
 
     dataBus = value;
 
-    switch ((addr >> 1) & 0xFF) {
+    (this->*customPokeTable[s][(addr >> 1) & 0xFF])(addr, value);
+}
+
+template <isize nr> u16
+Memory::peekCustomReg(u32 addr)
+{
+    u16 result;
+
+    switch (nr) {
+            
+        case 0x000 >> 1: // BLTDDAT
+            result = 0xFFFF; break;
+        case 0x002 >> 1: // DMACONR
+            result = agnus.peekDMACONR(); break;
+        case 0x004 >> 1: // VPOSR
+            result = agnus.peekVPOSR(); break;
+        case 0x006 >> 1: // VHPOSR
+            result = agnus.peekVHPOSR(); break;
+        case 0x008 >> 1: // DSKDATR
+            result = paula.diskController.peekDSKDATR(); break;
+        case 0x00A >> 1: // JOY0DAT
+            result = denise.peekJOY0DATR(); break;
+        case 0x00C >> 1: // JOY1DAT
+            result = denise.peekJOY1DATR(); break;
+        case 0x00E >> 1: // CLXDAT
+            result = denise.peekCLXDAT(); break;
+        case 0x010 >> 1: // ADKCONR
+            result = paula.peekADKCONR(); break;
+        case 0x012 >> 1: // POT0DAT
+            result = paula.peekPOTxDAT<0>(); break;
+        case 0x014 >> 1: // POT1DAT
+            result = paula.peekPOTxDAT<1>(); break;
+        case 0x016 >> 1: // POTGOR
+            result = paula.peekPOTGOR(); break;
+        case 0x018 >> 1: // SERDATR
+            result = uart.peekSERDATR(); break;
+        case 0x01A >> 1: // DSKBYTR
+            result = diskController.peekDSKBYTR(); break;
+        case 0x01C >> 1: // INTENAR
+            result = paula.peekINTENAR(); break;
+        case 0x01E >> 1: // INTREQR
+            result = paula.peekINTREQR(); break;
+        case 0x07C >> 1: // DENISEID
+            result = denise.peekDENISEID(); break;
+        default:
+            result = peekCustomFaulty16(addr);
+
+    }
+
+    return result;
+}
+
+template <Accessor s, isize nr> void
+Memory::pokeCustomReg(u32 addr, u16 value)
+{
+    switch (nr) {
 
         case 0x020 >> 1: // DSKPTH
             agnus.pokeDSKPTH(value); return;
@@ -2282,11 +2685,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x13E >> 1: // SPR7PTL
             agnus.pokeSPRxPTL<7>(value); return;
         case 0x140 >> 1: // SPR0POS
-            agnus.pokeSPRxPOS<0>(value);
+            agnus.pokeSPRxPOS<0, s>(value);
             denise.pokeSPRxPOS<0>(value);
             return;
         case 0x142 >> 1: // SPR0CTL
-            agnus.pokeSPRxCTL<0>(value);
+            agnus.pokeSPRxCTL<0, s>(value);
             denise.pokeSPRxCTL<0>(value);
             return;
         case 0x144 >> 1: // SPR0DATA
@@ -2294,11 +2697,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x146 >> 1: // SPR0DATB
             denise.pokeSPRxDATB<0>(value); return;
         case 0x148 >> 1: // SPR1POS
-            agnus.pokeSPRxPOS<1>(value);
+            agnus.pokeSPRxPOS<1, s>(value);
             denise.pokeSPRxPOS<1>(value);
             return;
         case 0x14A >> 1: // SPR1CTL
-            agnus.pokeSPRxCTL<1>(value);
+            agnus.pokeSPRxCTL<1, s>(value);
             denise.pokeSPRxCTL<1>(value);
             return;
         case 0x14C >> 1: // SPR1DATA
@@ -2306,11 +2709,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x14E >> 1: // SPR1DATB
             denise.pokeSPRxDATB<1>(value); return;
         case 0x150 >> 1: // SPR2POS
-            agnus.pokeSPRxPOS<2>(value);
+            agnus.pokeSPRxPOS<2, s>(value);
             denise.pokeSPRxPOS<2>(value);
             return;
         case 0x152 >> 1: // SPR2CTL
-            agnus.pokeSPRxCTL<2>(value);
+            agnus.pokeSPRxCTL<2, s>(value);
             denise.pokeSPRxCTL<2>(value);
             return;
         case 0x154 >> 1: // SPR2DATA
@@ -2318,11 +2721,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x156 >> 1: // SPR2DATB
             denise.pokeSPRxDATB<2>(value); return;
         case 0x158 >> 1: // SPR3POS
-            agnus.pokeSPRxPOS<3>(value);
+            agnus.pokeSPRxPOS<3, s>(value);
             denise.pokeSPRxPOS<3>(value);
             return;
         case 0x15A >> 1: // SPR3CTL
-            agnus.pokeSPRxCTL<3>(value);
+            agnus.pokeSPRxCTL<3, s>(value);
             denise.pokeSPRxCTL<3>(value);
             return;
         case 0x15C >> 1: // SPR3DATA
@@ -2330,11 +2733,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x15E >> 1: // SPR3DATB
             denise.pokeSPRxDATB<3>(value); return;
         case 0x160 >> 1: // SPR4POS
-            agnus.pokeSPRxPOS<4>(value);
+            agnus.pokeSPRxPOS<4, s>(value);
             denise.pokeSPRxPOS<4>(value);
             return;
         case 0x162 >> 1: // SPR4CTL
-            agnus.pokeSPRxCTL<4>(value);
+            agnus.pokeSPRxCTL<4, s>(value);
             denise.pokeSPRxCTL<4>(value);
             return;
         case 0x164 >> 1: // SPR4DATA
@@ -2342,11 +2745,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x166 >> 1: // SPR4DATB
             denise.pokeSPRxDATB<4>(value); return;
         case 0x168 >> 1: // SPR5POS
-            agnus.pokeSPRxPOS<5>(value);
+            agnus.pokeSPRxPOS<5, s>(value);
             denise.pokeSPRxPOS<5>(value);
             return;
         case 0x16A >> 1: // SPR5CTL
-            agnus.pokeSPRxCTL<5>(value);
+            agnus.pokeSPRxCTL<5, s>(value);
             denise.pokeSPRxCTL<5>(value);
             return;
         case 0x16C >> 1: // SPR5DATA
@@ -2354,11 +2757,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x16E >> 1: // SPR5DATB
             denise.pokeSPRxDATB<5>(value); return;
         case 0x170 >> 1: // SPR6POS
-            agnus.pokeSPRxPOS<6>(value);
+            agnus.pokeSPRxPOS<6, s>(value);
             denise.pokeSPRxPOS<6>(value);
             return;
         case 0x172 >> 1: // SPR6CTL
-            agnus.pokeSPRxCTL<6>(value);
+            agnus.pokeSPRxCTL<6, s>(value);
             denise.pokeSPRxCTL<6>(value);
             return;
         case 0x174 >> 1: // SPR6DATA
@@ -2366,11 +2769,11 @@ Memory::pokeCustom16(u32 addr, u16 value)
         case 0x176 >> 1: // SPR6DATB
             denise.pokeSPRxDATB<6>(value); return;
         case 0x178 >> 1: // SPR7POS
-            agnus.pokeSPRxPOS<7>(value);
+            agnus.pokeSPRxPOS<7, s>(value);
             denise.pokeSPRxPOS<7>(value);
             return;
         case 0x17A >> 1: // SPR7CTL
-            agnus.pokeSPRxCTL<7>(value);
+            agnus.pokeSPRxCTL<7, s>(value);
             denise.pokeSPRxCTL<7>(value);
             return;
         case 0x17C >> 1: // SPR7DATA
@@ -2454,6 +2857,16 @@ Memory::pokeCustom16(u32 addr, u16 value)
     }
 }
 
+template <isize nr> void
+Memory::initCustomTables()
+{
+    customPeekTable[nr] = &Memory::peekCustomReg<nr>;
+    customPokeTable[ACCESSOR_CPU][nr] = &Memory::pokeCustomReg<ACCESSOR_CPU, nr>;
+    customPokeTable[ACCESSOR_AGNUS][nr] = &Memory::pokeCustomReg<ACCESSOR_AGNUS, nr>;
+
+    if constexpr (nr < 255) initCustomTables<nr + 1>();
+}
+
 template <Accessor A> const char *
 Memory::ascii(u32 addr)
 {
@@ -12,6 +12,9 @@
 #include "MemoryTypes.h"
 #include "AmigaComponent.h"
 #include "RomFileTypes.h"
+#include "MemHeatmap.h"
+#include "MemTracer.h"
+#include "RomImage.h"
 
 // DEPRECATED. TODO: GET VALUE FROM ZORRO CARD MANANGER
 const u32 FAST_RAM_STRT = 0x200000;
@@ -70,21 +73,32 @@ assert((x) >= 0xE80000 && (x) <= 0xE8FFFF);
 // Writing
 //
 
+// Increments the write generation of the page holding a canonical address
+#define TOUCH_PAGE(x) pageGen[((x) & 0xFFFFFF) >> 12]++
+
 // Writes a value into Chip RAM in big endian format
-#define WRITE_CHIP_8(x,y)  W8BE_ALIGNED (chip + ((x) & chipMask), (y))
-#define WRITE_CHIP_16(x,y) W16BE_ALIGNED(chip + ((x) & chipMask), (y))
+#define WRITE_CHIP_8(x,y) \
+{ W8BE_ALIGNED (chip + ((x) & chipMask), (y)); TOUCH_PAGE((x) & chipMask); }
+#define WRITE_CHIP_16(x,y) \
+{ W16BE_ALIGNED(chip + ((x) & chipMask), (y)); TOUCH_PAGE((x) & chipMask); }
 
 // Writes a value into Fast RAM in big endian format
-#define WRITE_FAST_8(x,y)  W8BE_ALIGNED (fast + ((x) - FAST_RAM_STRT), (y))
-#define WRITE_FAST_16(x,y) W16BE_ALIGNED(fast + ((x) - FAST_RAM_STRT), (y))
+#define WRITE_FAST_8(x,y) \
+{ W8BE_ALIGNED (fast + ((x) - FAST_RAM_STRT), (y)); TOUCH_PAGE(x); }
+#define WRITE_FAST_16(x,y) \
+{ W16BE_ALIGNED(fast + ((x) - FAST_RAM_STRT), (y)); TOUCH_PAGE(x); }
 
 // Writes a value into Slow RAM in big endian format
-#define WRITE_SLOW_8(x,y)  W8BE_ALIGNED (slow + ((x) & slowMask), (y))
-#define WRITE_SLOW_16(x,y) W16BE_ALIGNED(slow + ((x) & slowMask), (y))
+#define WRITE_SLOW_8(x,y) \
+{ W8BE_ALIGNED (slow + ((x) & slowMask), (y)); TOUCH_PAGE(0xC00000 + ((x) & slowMask)); }
+#define WRITE_SLOW_16(x,y) \
+{ W16BE_ALIGNED(slow + ((x) & slowMask), (y)); TOUCH_PAGE(0xC00000 + ((x) & slowMask)); }
 
 // Writes a value into Kickstart WOM in big endian format
-#define WRITE_WOM_8(x,y)  W8BE_ALIGNED (wom + ((x) & womMask), (y))
-#define WRITE_WOM_16(x,y) W16BE_ALIGNED(wom + ((x) & womMask), (y))
+#define WRITE_WOM_8(x,y) \
+{ W8BE_ALIGNED (wom + ((x) & womMask), (y)); TOUCH_PAGE(0xF80000 + ((x) & womMask)); }
+#define WRITE_WOM_16(x,y) \
+{ W16BE_ALIGNED(wom + ((x) & womMask), (y)); TOUCH_PAGE(0xF80000 + ((x) & womMask)); }
 
 // Writes a value into Extended ROM in big endian format
 #define WRITE_EXT_8(x,y)  W8BE_ALIGNED (ext + ((x) & extMask), (y))
@@ -101,6 +115,12 @@ class Memory : public AmigaComponent {
 
 public:
 
+    // Per-frame access statistics (only collected if MEM_HEATMAP is set)
+    MemHeatmap heatmap;
+
+    // Bus transaction recorder (only active if started)
+    MemTracer tracer;
+
     /* About
      *
      * There are 6 types of dynamically allocated memory:
@@ -143,6 +163,8 @@ public:
      *    pointer == nullptr <=> config.size == 0 <=> mask == 0
      *    pointer != nullptr <=> mask == config.size - 1
      *
+     * Rom and extended Rom are not owned by this component. They point into
+     * RomImage objects which are shared among all emulator instances.
      */
     u8 *rom = nullptr;
     u8 *wom = nullptr;
@@ -158,6 +180,10 @@ public:
     u32 slowMask = 0;
     u32 fastMask = 0;
 
+    // The shared images backing the Kickstart Rom and the extended Rom
+    std::shared_ptr<RomImage> romImage;
+    std::shared_ptr<RomImage> extImage;
+
     /* Indicates if the Kickstart Wom is writable. If an Amiga 1000 Boot Rom is
      * installed, a Kickstart WOM (Write Once Memory) is added automatically.
      * On startup, the WOM is unlocked which means that it is writable. During
@@ -173,6 +199,39 @@ public:
     MemorySource cpuMemSrc[256];
     MemorySource agnusMemSrc[256];
 
+    /* Fast path lookup tables for CPU accesses. For each bank whose memory
+     * can be accessed without side effects, the tables store a host pointer
+     * and an offset mask. The host address of a memory cell is computed as
+     * base + (addr & mask). The tables also store a reference to the
+     * statistics counter of the bank. Banks with a nullptr base pointer are
+     * accessed via the standard path.
+     * See also: updateCpuPageTable()
+     */
+    struct PageEntry { u8 *base; u32 mask; long *counter; };
+    PageEntry cpuReadPage[256];
+    PageEntry cpuWritePage[256];
+
+    /* Jump tables for accessing the custom chip registers. The tables are
+     * indexed by the register number (addr >> 1) & 0xFF and store pointers
+     * to the register specific handlers peekCustomReg() and pokeCustomReg().
+     * See also: initCustomTables()
+     */
+    typedef u16 (Memory::*CustomPeekHandler)(u32);
+    typedef void (Memory::*CustomPokeHandler)(u32, u16);
+    CustomPeekHandler customPeekTable[256];
+    CustomPokeHandler customPokeTable[2][256];
+
+    /* Write generation counters. The address space is divided into 4 KB
+     * pages, each of which has a counter that is incremented whenever a Ram
+     * cell in this page is written to, no matter who the accessor is.
+     * Mirrored Ram is counted under its canonical address. The epoch is
+     * incremented whenever memory is remapped or overwritten in bulk, which
+     * invalidates all pages at once.
+     * See also: getGeneration()
+     */
+    u32 pageGen[4096] = { };
+    u32 genEpoch = 1;
+
     // The last value on the data bus
     u16 dataBus;
 
@@ -267,6 +326,13 @@ private:
     isize didLoadFromBuffer(const u8 *buffer) override;
     isize didSaveToBuffer(u8 *buffer) const override;
 
+    /* Fast Ram is serialized page by page. Pages containing zeroes only are
+     * skipped, because the lazy allocator recreates them free of charge.
+     */
+    static constexpr isize fastPageSize = KB(4);
+    bool isZeroPage(const u8 *page) const;
+    i32 countFastPages() const;
+
     
     //
     // Controlling
@@ -284,27 +350,56 @@ private:
 private:
     
     /* Dynamically allocates Ram or Rom. As side effects, the memory table is
-     * updated and the GUI is informed about the changed memory layout.
+     * updated and the GUI is informed about the changed memory layout. If
+     * 'lazy' is set, the memory is reserved as an anonymous memory mapping.
+     * In this case, the host commits physical pages on their first use and
+     * untouched memory costs nothing.
+     */
+    bool alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask, bool lazy = false);
+
+    // Reserves or releases lazily committed memory
+    static u8 *mapLazy(isize bytes);
+    static void unmapLazy(u8 *ptr, isize bytes);
+
+    /* Replaces the contents of lazily committed memory by an init pattern.
+     * The memory is remapped copy-on-write from a pattern file which is
+     * shared among all instances, starting at the given file offset. Pages
+     * are materialized on the first write. Returns false if the memory could
+     * not be remapped.
      */
-    bool alloc(i32 bytes, u8 *&ptr, i32 &size, u32 &mask);
+    static bool initLazy(u8 *ptr, isize bytes, RamInitPattern pattern, isize offset);
 
 public:
 
-    bool allocChip(i32 bytes) { return alloc(bytes, chip, config.chipSize, chipMask); }
-    bool allocSlow(i32 bytes) { return alloc(bytes, slow, config.slowSize, slowMask); }
-    bool allocFast(i32 bytes) { return alloc(bytes, fast, config.fastSize, fastMask); }
+    bool allocChip(i32 bytes) { return alloc(bytes, chip, config.chipSize, chipMask, true); }
+    bool allocSlow(i32 bytes) { return alloc(bytes, slow, config.slowSize, slowMask, true); }
+    bool allocFast(i32 bytes) { return alloc(bytes, fast, config.fastSize, fastMask, true); }
 
     void deleteChip() { allocChip(0); }
     void deleteSlow() { allocSlow(0); }
     void deleteFast() { allocFast(0); }
 
-    bool allocRom(i32 bytes) { return alloc(bytes, rom, config.romSize, romMask); }
     bool allocWom(i32 bytes) { return alloc(bytes, wom, config.womSize, womMask); }
-    bool allocExt(i32 bytes) { return alloc(bytes, ext, config.extSize, extMask); }
 
-    void deleteRom() { allocRom(0); }
+    void deleteRom() { attachRom(nullptr); }
     void deleteWom() { allocWom(0); }
-    void deleteExt() { allocExt(0); }
+    void deleteExt() { attachExt(nullptr); }
+
+private:
+
+    /* Installs a shared Rom image. The previously installed image is released.
+     * As side effects, the memory table is updated and the GUI is informed
+     * about the changed memory layout.
+     */
+    void attach(std::shared_ptr<RomImage> image,
+                std::shared_ptr<RomImage> &slot, u8 *&ptr, i32 &size, u32 &mask);
+
+public:
+
+    void attachRom(std::shared_ptr<RomImage> image) {
+        attach(image, romImage, rom, config.romSize, romMask); }
+    void attachExt(std::shared_ptr<RomImage> image) {
+        attach(image, extImage, ext, config.extSize, extMask); }
 
 
     //
@@ -360,9 +455,9 @@ public:
     bool hasExt() { return ext != nullptr; }
 
     // Erases an installed Rom
-    void eraseRom() { memset(rom, 0, config.romSize); }
+    void eraseRom();
     void eraseWom() { memset(wom, 0, config.womSize); }
-    void eraseExt() { memset(ext, 0, config.extSize); }
+    void eraseExt();
     
     // Installs a Boot Rom or Kickstart Rom
     void loadRom(class RomFile *rom) throws;
@@ -377,13 +472,6 @@ public:
     void loadExtFromBuffer(const u8 *buf, isize len) throws;
     void loadExtFromBuffer(const u8 *buf, isize len, ErrorCode *ec);
     
-private:
-
-     // Loads Rom data from a file
-    // DEPRECATED: USE AnyAmigaFile::flash(...) instead
-    void loadRom(class AmigaFile *rom, u8 *target, isize length);
-    
-public:
     
     // Saves a Rom to disk
     void saveRom(const char *path) throws;
@@ -412,6 +500,9 @@ private:
     void updateCpuMemSrcTable();
     void updateAgnusMemSrcTable();
 
+    // Derives the CPU fast path lookup tables from cpuMemSrc
+    void updateCpuPageTable();
+
     
     //
     // Accessing memory
@@ -430,6 +521,14 @@ public:
     template <Accessor acc, MemorySource src> void poke16(u32 addr, u16 value);
     template <Accessor acc> void poke8(u32 addr, u8 value);
     template <Accessor acc> void poke16(u32 addr, u16 value);
+
+    /* Returns the write generation of the 4 KB page containing the provided
+     * CPU address. The value changes whenever the page might have been
+     * modified, which makes it suitable for validating cached data. Zero is
+     * returned for pages that are not backed by memory (I/O registers,
+     * unmapped areas). These pages must not be cached.
+     */
+    u64 getGeneration(u32 addr) const;
     
 
     //
@@ -470,6 +569,17 @@ public:
     u16 spypeekCustom16(u32 addr) const;
  
     template <Accessor s> void pokeCustom16(u32 addr, u16 value);
+
+private:
+    
+    // Register specific handlers (stored in the jump tables)
+    template <isize nr> u16 peekCustomReg(u32 addr);
+    template <Accessor s, isize nr> void pokeCustomReg(u32 addr, u16 value);
+
+    // Sets up the jump tables
+    template <isize nr> void initCustomTables();
+
+public:
     
     
     //
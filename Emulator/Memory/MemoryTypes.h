@@ -141,6 +141,11 @@ struct BankMapEnum : util::Reflection<BankMapEnum, BankMap> {
 };
 #endif
 
+/* Initial Ram contents. RAM_INIT_RANDOMIZED fills all Ram banks with a single
+ * xorshift32 byte stream (seed 0x2545F491, Chip Ram first, followed by Slow
+ * Ram and Fast Ram). The stream is identical on all hosts. Older releases used
+ * the C library's rand() seeded with 0, which yields a different pattern.
+ */
 enum_long(RAM_INIT_PATTERN)
 {
     RAM_INIT_RANDOMIZED,
@@ -0,0 +1,72 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "RomImage.h"
+#include "Checksum.h"
+#include <cstring>
+#include <sys/mman.h>
+
+std::unordered_map<u64, std::weak_ptr<RomImage>> RomImage::registry;
+util::ReentrantMutex RomImage::registryLock;
+
+std::shared_ptr<RomImage>
+RomImage::make(const u8 *buf, isize len)
+{
+    assert(buf);
+    assert(len > 0);
+
+    util::AutoMutex _am(registryLock);
+
+    auto hash = util::fnv_1a_64(buf, len);
+
+    // Reuse the existing image if the same Rom is already in use
+    if (auto image = find(hash, len)) {
+        if (memcmp(image->data, buf, len) == 0) return image;
+    }
+
+    // Create a new image
+    void *ptr = mmap(nullptr, len, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (ptr == MAP_FAILED) return nullptr;
+
+    memcpy(ptr, buf, len);
+    mprotect(ptr, len, PROT_READ);
+
+    auto image = std::shared_ptr<RomImage>(new RomImage());
+    image->data = (u8 *)ptr;
+    image->size = len;
+    image->hash = hash;
+
+    registry[hash] = image;
+    return image;
+}
+
+std::shared_ptr<RomImage>
+RomImage::find(u64 hash, isize len)
+{
+    util::AutoMutex _am(registryLock);
+
+    auto it = registry.find(hash);
+    if (it == registry.end()) return nullptr;
+
+    auto image = it->second.lock();
+    return image && image->size == len ? image : nullptr;
+}
+
+RomImage::~RomImage()
+{
+    util::AutoMutex _am(registryLock);
+
+    // Remove the registry entry unless it has been taken over by another image
+    auto it = registry.find(hash);
+    if (it != registry.end() && it->second.expired()) registry.erase(it);
+
+    if (data) munmap(data, size);
+}
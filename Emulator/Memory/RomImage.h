@@ -0,0 +1,59 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include "Concurrency.h"
+#include <memory>
+#include <unordered_map>
+
+/* A RomImage is an immutable Rom dump which is shared among all emulator
+ * instances living in the same process. Images are reference counted and
+ * identified by their FNV-1a checksum. If two instances load the same Rom,
+ * both refer to a single copy. The data is stored in a memory mapping which
+ * is write-protected after the image has been created.
+ */
+class RomImage
+{
+    // All images that are currently in use, indexed by their checksum
+    static std::unordered_map<u64, std::weak_ptr<RomImage>> registry;
+    static util::ReentrantMutex registryLock;
+
+public:
+
+    // The Rom data
+    u8 *data = nullptr;
+
+    // The size of the Rom data in bytes
+    isize size = 0;
+
+    // The FNV-1a checksum of the Rom data
+    u64 hash = 0;
+
+
+    //
+    // Initializing
+    //
+
+public:
+
+    // Returns an image with the provided contents (nullptr if out of memory)
+    static std::shared_ptr<RomImage> make(const u8 *buf, isize len);
+
+    // Looks up an image that is currently in use (nullptr if not found)
+    static std::shared_ptr<RomImage> find(u64 hash, isize len);
+
+    RomImage(const RomImage&) = delete;
+    ~RomImage();
+
+private:
+
+    RomImage() { };
+};
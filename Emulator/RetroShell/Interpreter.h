@@ -26,18 +26,19 @@ enum class Token
     dc, keyboard, memory, monitor, mouse, paula, serial, rtc,
 
     // Commands
-    about, audiate, autosync, clear, config, connect, disconnect, dsksync,
-    easteregg, eject, close, insert, inspect, list, load, lock, on, off, pause,
-    reset, run, set, source,
+    about, audiate, autosync, clear, config, connect, convert, coverage, diff,
+    disassemble, disconnect, dsksync, easteregg, eject, close, heatmap, insert,
+    inspect, list, load, lock, on, off, pause, profiler, reset, run, save, set,
+    source, start, stop, timeline, trace,
     
     // Categories
-    checksums, devices, events, registers, state,
+    checksums, devices, dma, events, registers, state,
     
     // Keys
     accuracy, bankmap, brightness, chip, clxsprspr, clxsprplf, clxplfplf,
     contrast, defaultbb, defaultfs, device, esync, extrom, extstart, fast,
-    filter, joystick, keyset, mechanics, model, palette, pan, poll, pullup,
-    raminitpattern, revision, rom, sampling, saturation, searchpath,
+    filter, frames, interval, joystick, keyset, mechanics, model, palette, pan, poll,
+    pullup, raminitpattern, range, revision, rom, sampling, saturation, searchpath,
     shakedetector, slow, slowramdelay, slowrammirror, speed, step, tod, todbug,
     unmappingtype, velocity, volume, wom
 };
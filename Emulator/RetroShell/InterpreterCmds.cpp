@@ -145,6 +145,52 @@ Interpreter::registerInstructions()
              "command", "Computes memory checksums",
              &RetroShell::exec <Token::memory, Token::inspect, Token::checksums>);
 
+    root.add({"memory", "heatmap"},
+             "command", "Records memory accesses per page and frame");
+
+    root.add({"memory", "heatmap", "start"},
+             "command", "Starts recording into a file",
+             &RetroShell::exec <Token::memory, Token::heatmap, Token::start>, 1);
+
+    root.add({"memory", "heatmap", "stop"},
+             "command", "Stops recording",
+             &RetroShell::exec <Token::memory, Token::heatmap, Token::stop>);
+
+    root.add({"memory", "heatmap", "clear"},
+             "command", "Resets all counters",
+             &RetroShell::exec <Token::memory, Token::heatmap, Token::clear>);
+
+    root.add({"memory", "heatmap", "inspect"},
+             "command", "Displays the most frequently accessed pages",
+             &RetroShell::exec <Token::memory, Token::heatmap, Token::inspect>);
+
+    root.add({"memory", "trace"},
+             "command", "Records all bus transactions");
+
+    root.add({"memory", "trace", "start"},
+             "command", "Starts recording into a file",
+             &RetroShell::exec <Token::memory, Token::trace, Token::start>, 1);
+
+    root.add({"memory", "trace", "stop"},
+             "command", "Stops recording",
+             &RetroShell::exec <Token::memory, Token::trace, Token::stop>);
+
+    root.add({"memory", "trace", "range"},
+             "key", "Restricts recording to an address range",
+             &RetroShell::exec <Token::memory, Token::trace, Token::range>, 2);
+
+    root.add({"memory", "trace", "cpu"},
+             "key", "Enables or disables recording of CPU accesses",
+             &RetroShell::exec <Token::memory, Token::trace, Token::cpu>, 1);
+
+    root.add({"memory", "trace", "agnus"},
+             "key", "Enables or disables recording of DMA accesses",
+             &RetroShell::exec <Token::memory, Token::trace, Token::agnus>, 1);
+
+    root.add({"memory", "trace", "inspect"},
+             "command", "Displays the current state",
+             &RetroShell::exec <Token::memory, Token::trace, Token::inspect>);
+
     
     //
     // CPU
@@ -164,6 +210,87 @@ Interpreter::registerInstructions()
              "command", "Displays the current register values",
              &RetroShell::exec <Token::cpu, Token::inspect, Token::registers>);
 
+    root.add({"cpu", "disassemble"},
+             "command", "Disassembles instructions starting at an address",
+             &RetroShell::exec <Token::cpu, Token::disassemble>, 1);
+
+    root.add({"cpu", "profiler"},
+             "command", "Samples the program counter");
+
+    root.add({"cpu", "profiler", "on"},
+             "state", "Starts the profiler",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::on>);
+
+    root.add({"cpu", "profiler", "off"},
+             "state", "Stops the profiler",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::off>);
+
+    root.add({"cpu", "profiler", "clear"},
+             "command", "Deletes all recorded samples",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::clear>);
+
+    root.add({"cpu", "profiler", "interval"},
+             "key", "Sets the number of instructions between two samples",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::interval>, 1);
+
+    root.add({"cpu", "profiler", "inspect"},
+             "command", "Displays the hottest code locations",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::inspect>);
+
+    root.add({"cpu", "profiler", "save"},
+             "command", "Exports the profile in folded-stack format",
+             &RetroShell::exec <Token::cpu, Token::profiler, Token::save>, 1);
+
+    root.add({"cpu", "coverage"},
+             "command", "Records executed instruction addresses");
+
+    root.add({"cpu", "coverage", "on"},
+             "state", "Starts recording",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::on>);
+
+    root.add({"cpu", "coverage", "off"},
+             "state", "Stops recording",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::off>);
+
+    root.add({"cpu", "coverage", "clear"},
+             "command", "Resets the coverage map",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::clear>);
+
+    root.add({"cpu", "coverage", "inspect"},
+             "command", "Displays the number of executed words",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::inspect>);
+
+    root.add({"cpu", "coverage", "save"},
+             "command", "Saves the coverage map to a file",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::save>, 1);
+
+    root.add({"cpu", "coverage", "diff"},
+             "command", "Compares the coverage map with a saved one",
+             &RetroShell::exec <Token::cpu, Token::coverage, Token::diff>, 1);
+
+    root.add({"cpu", "trace"},
+             "command", "Streams executed instructions into a file");
+
+    root.add({"cpu", "trace", "start"},
+             "command", "Starts recording into a file",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::start>, 1);
+
+    root.add({"cpu", "trace", "stop"},
+             "command", "Stops recording",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::stop>);
+
+    root.add({"cpu", "trace", "registers"},
+             "key", "Enables or disables recording of register contents",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::registers>, 1);
+
+    root.add({"cpu", "trace", "inspect"},
+             "command", "Displays the recording status",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::inspect>);
+
+    root.add({"cpu", "trace", "convert"},
+             "command", "Disassembles a trace file into a text file",
+             &RetroShell::exec <Token::cpu, Token::trace, Token::convert>, 2);
+
     
     //
     // CIA
@@ -246,6 +373,33 @@ Interpreter::registerInstructions()
     root.add({"agnus", "inspect", "events"},
              "category", "Displays scheduled events",
              &RetroShell::exec <Token::agnus, Token::inspect, Token::events>);
+
+    root.add({"agnus", "inspect", "dma"},
+             "category", "Displays the bus utilisation of the latest frame",
+             &RetroShell::exec <Token::agnus, Token::inspect, Token::dma>);
+
+    root.add({"agnus", "timeline"},
+             "command", "Records the bus usage of all rasterlines");
+
+    root.add({"agnus", "timeline", "start"},
+             "command", "Starts recording into a file",
+             &RetroShell::exec <Token::agnus, Token::timeline, Token::start>, 1);
+
+    root.add({"agnus", "timeline", "stop"},
+             "command", "Stops recording",
+             &RetroShell::exec <Token::agnus, Token::timeline, Token::stop>);
+
+    root.add({"agnus", "timeline", "frames"},
+             "key", "Limits recording to a number of frames (0 = unlimited)",
+             &RetroShell::exec <Token::agnus, Token::timeline, Token::frames>, 1);
+
+    root.add({"agnus", "timeline", "convert"},
+             "command", "Converts a recording into a Chrome trace file",
+             &RetroShell::exec <Token::agnus, Token::timeline, Token::convert>, 2);
+
+    root.add({"agnus", "timeline", "inspect"},
+             "command", "Displays the current state",
+             &RetroShell::exec <Token::agnus, Token::timeline, Token::inspect>);
     
     
     //
@@ -296,6 +450,21 @@ Interpreter::registerInstructions()
              "category", "Displays the current register value",
              &RetroShell::exec <Token::copper, Token::inspect, Token::registers>);
 
+    root.add({"copper", "profiler"},
+             "command", "Records execution statistics per frame");
+
+    root.add({"copper", "profiler", "clear"},
+             "command", "Deletes all recorded frames",
+             &RetroShell::exec <Token::copper, Token::profiler, Token::clear>);
+
+    root.add({"copper", "profiler", "inspect"},
+             "command", "Displays averages and the most frequently written registers",
+             &RetroShell::exec <Token::copper, Token::profiler, Token::inspect>);
+
+    root.add({"copper", "profiler", "save"},
+             "command", "Exports all recorded frames in CSV format",
+             &RetroShell::exec <Token::copper, Token::profiler, Token::save>, 1);
+
     
     //
     // Denise
@@ -191,6 +191,114 @@ RetroShell::exec <Token::memory, Token::inspect, Token::checksums> (Arguments& a
     dump(amiga.mem, Dump::Checksums);
 }
 
+template <> void
+RetroShell::exec <Token::memory, Token::heatmap, Token::start> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    bool success = amiga.mem.heatmap.start(argv.front());
+    amiga.resume();
+
+    if (!success) throw VAError(ERROR_FILE_CANT_CREATE);
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::heatmap, Token::stop> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.mem.heatmap.stop();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::heatmap, Token::clear> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.mem.heatmap.clear();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::heatmap, Token::inspect> (Arguments& argv, long param)
+{
+    auto &heatmap = amiga.mem.heatmap;
+    std::stringstream ss; string line;
+
+    if (!MEM_HEATMAP) {
+        *this << "The heatmap collector is disabled (MEM_HEATMAP = 0)" << '\n';
+        return;
+    }
+
+    amiga.suspend();
+    heatmap.dump(ss, 16);
+    amiga.resume();
+
+    *this << "Recording: " << (heatmap.isRunning() ? "yes" : "no") << '\n';
+    *this << "Written:   " << (long)heatmap.bytesWritten() << " bytes" << '\n';
+    *this << "Dropped:   " << (long)heatmap.bytesDropped() << " bytes" << '\n';
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::start> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    bool success = amiga.mem.tracer.start(argv.front());
+    amiga.resume();
+
+    if (!success) throw VAError(ERROR_FILE_CANT_CREATE);
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::stop> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.mem.tracer.stop();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::range> (Arguments& argv, long param)
+{
+    auto lo = (u32)util::parseNum(argv.front());
+    auto hi = (u32)util::parseNum(argv.back());
+    
+    amiga.suspend();
+    amiga.mem.tracer.setRange(lo, hi);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::cpu> (Arguments& argv, long param)
+{
+    auto value = util::parseBool(argv.front());
+    
+    amiga.suspend();
+    amiga.mem.tracer.setAccessor(ACCESSOR_CPU, value);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::agnus> (Arguments& argv, long param)
+{
+    auto value = util::parseBool(argv.front());
+    
+    amiga.suspend();
+    amiga.mem.tracer.setAccessor(ACCESSOR_AGNUS, value);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::memory, Token::trace, Token::inspect> (Arguments& argv, long param)
+{
+    std::stringstream ss; string line;
+
+    amiga.suspend();
+    amiga.mem.tracer.dump(ss);
+    amiga.resume();
+
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
 //
 // CPU
 //
@@ -207,6 +315,205 @@ RetroShell::exec <Token::cpu, Token::inspect, Token::registers> (Arguments& argv
     dump(amiga.cpu, Dump::Registers);
 }
 
+template <> void
+RetroShell::exec <Token::cpu, Token::disassemble> (Arguments& argv, long param)
+{
+    DasmLine lines[16];
+    auto addr = (u32)util::parseNum(argv.front());
+    
+    amiga.cpu.disassembleRange(addr, 16, lines);
+
+    for (isize i = 0; i < 16; i++) {
+
+        *this << amiga.cpu.disassembleAddr(lines[i].addr) << "  ";
+        *this << lines[i].instr << '\n';
+    }
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::on> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.enable();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::off> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.disable();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::clear> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.clear();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::interval> (Arguments& argv, long param)
+{
+    auto value = util::parseNum(argv.front());
+    if (value < 1) throw ConfigArgError("1, 2, ...");
+
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.setInterval(value);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::inspect> (Arguments& argv, long param)
+{
+    std::stringstream ss; string line;
+
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.dumpHotspots(ss);
+    amiga.resume();
+
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::profiler, Token::save> (Arguments& argv, long param)
+{
+    std::ofstream stream(argv.front());
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE);
+
+    amiga.suspend();
+    amiga.cpu.debugger.profiler.exportFolded(stream);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::on> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.coverage.enable();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::off> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.coverage.disable();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::clear> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.coverage.clear();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::inspect> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    auto words = amiga.cpu.debugger.coverage.coveredWords();
+    amiga.resume();
+
+    *this << "Executed words: " << words << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::save> (Arguments& argv, long param)
+{
+    auto &coverage = amiga.cpu.debugger.coverage;
+    
+    std::ofstream stream(argv.front(), std::ios::binary);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE);
+
+    amiga.suspend();
+    if (coverage.getBitmap()) {
+        stream.write((const char *)coverage.getBitmap(), coverage.bitmapSize);
+    } else {
+        for (isize i = 0; i < coverage.bitmapSize; i++) stream.put(0);
+    }
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::coverage, Token::diff> (Arguments& argv, long param)
+{
+    auto &coverage = amiga.cpu.debugger.coverage;
+    auto path = argv.front();
+    
+    if (!util::fileExists(path)) throw ConfigFileNotFoundError(path);
+    if (util::getSizeOfFile(path) != coverage.bitmapSize) throw ConfigFileReadError(path);
+
+    u8 *buffer; isize size;
+    if (!util::loadFile(path, &buffer, &size)) throw ConfigFileReadError(path);
+
+    std::stringstream ss; string line;
+
+    amiga.suspend();
+    coverage.diff(buffer, ss);
+    amiga.resume();
+    delete [] buffer;
+
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::start> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    bool success = amiga.cpu.debugger.tracer.start(argv.front());
+    amiga.resume();
+
+    if (!success) throw VAError(ERROR_FILE_CANT_CREATE);
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::stop> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.cpu.debugger.tracer.stop();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::registers> (Arguments& argv, long param)
+{
+    amiga.cpu.debugger.tracer.setRecordRegisters(util::parseBool(argv.front()));
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::inspect> (Arguments& argv, long param)
+{
+    auto &tracer = amiga.cpu.debugger.tracer;
+
+    *this << "Recording: " << (tracer.isRunning() ? "yes" : "no") << '\n';
+    *this << "Registers: " << (tracer.getRecordRegisters() ? "yes" : "no") << '\n';
+    *this << "Written:   " << (long)tracer.bytesWritten() << " bytes" << '\n';
+    *this << "Dropped:   " << (long)tracer.bytesDropped() << " bytes" << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::cpu, Token::trace, Token::convert> (Arguments& argv, long param)
+{
+    auto source = argv.front();
+    auto target = argv.back();
+
+    if (!util::fileExists(source)) throw ConfigFileNotFoundError(source);
+
+    std::ofstream stream(target);
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE);
+
+    amiga.suspend();
+    bool success = amiga.cpu.debugger.tracer.convert(source, stream);
+    amiga.resume();
+
+    if (!success) throw ConfigFileReadError(source);
+}
+
 //
 // CIA
 //
@@ -321,6 +628,62 @@ RetroShell::exec <Token::agnus, Token::inspect, Token::events> (Arguments &argv,
     dump(amiga.agnus, Dump::Events);
 }
 
+template <> void
+RetroShell::exec <Token::agnus, Token::inspect, Token::dma> (Arguments &argv, long param)
+{
+    dump(amiga.agnus, Dump::Dma);
+}
+
+template <> void
+RetroShell::exec <Token::agnus, Token::timeline, Token::start> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    bool success = amiga.agnus.timeline.start(argv.front());
+    amiga.resume();
+
+    if (!success) throw VAError(ERROR_FILE_CANT_CREATE);
+}
+
+template <> void
+RetroShell::exec <Token::agnus, Token::timeline, Token::stop> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.agnus.timeline.stop();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::agnus, Token::timeline, Token::frames> (Arguments& argv, long param)
+{
+    auto value = util::parseNum(argv.front());
+    if (value < 0) throw ConfigArgError("0, 1, 2, ...");
+
+    amiga.suspend();
+    amiga.agnus.timeline.setFrames(value);
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::agnus, Token::timeline, Token::convert> (Arguments& argv, long param)
+{
+    std::ofstream stream(argv.back());
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE);
+
+    if (!BusTimeline::convert(argv.front(), stream)) throw VAError(ERROR_FILE_CANT_READ);
+}
+
+template <> void
+RetroShell::exec <Token::agnus, Token::timeline, Token::inspect> (Arguments& argv, long param)
+{
+    std::stringstream ss; string line;
+
+    amiga.suspend();
+    amiga.agnus.timeline.dump(ss);
+    amiga.resume();
+
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
 //
 // Blitter
 //
@@ -365,6 +728,42 @@ RetroShell::exec <Token::copper, Token::inspect, Token::registers> (Arguments& a
     dump(amiga.agnus.copper, Dump::Registers);
 }
 
+template <> void
+RetroShell::exec <Token::copper, Token::profiler, Token::clear> (Arguments& argv, long param)
+{
+    amiga.suspend();
+    amiga.agnus.copper.profiler.clear();
+    amiga.resume();
+}
+
+template <> void
+RetroShell::exec <Token::copper, Token::profiler, Token::inspect> (Arguments& argv, long param)
+{
+    std::stringstream ss; string line;
+
+    if (!COP_PROFILE) {
+        *this << "The Copper profiler is disabled (COP_PROFILE = 0)" << '\n';
+        return;
+    }
+
+    amiga.suspend();
+    amiga.agnus.copper.profiler.dump(ss, 16);
+    amiga.resume();
+
+    while(std::getline(ss, line)) *this << line << '\n';
+}
+
+template <> void
+RetroShell::exec <Token::copper, Token::profiler, Token::save> (Arguments& argv, long param)
+{
+    std::ofstream stream(argv.front());
+    if (!stream.is_open()) throw VAError(ERROR_FILE_CANT_WRITE);
+
+    amiga.suspend();
+    amiga.agnus.copper.profiler.exportCSV(stream);
+    amiga.resume();
+}
+
 //
 // Denise
 //
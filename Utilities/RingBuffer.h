@@ -23,6 +23,13 @@ namespace util {
 
 template <class T, isize capacity> struct RingBuffer
 {
+    /* Indicates whether indices can be wrapped around by masking. The check
+     * is evaluated at compile time. Hence, buffers with a power-of-two
+     * capacity never execute a modulo operation.
+     */
+    static constexpr bool pow2 = (capacity & (capacity - 1)) == 0;
+    static isize wrap(isize i) { return pow2 ? (i & (capacity - 1)) : (i % capacity); }
+
     // Element storage
     T elements[capacity];
 
@@ -38,7 +45,7 @@ template <class T, isize capacity> struct RingBuffer
     
     void clear() { r = w = 0; }
     void clear(T t) { for (isize i = 0; i < capacity; i++) elements[i] = t; clear(); }
-    void align(isize offset) { w = (r + offset) % capacity; }
+    void align(isize offset) { w = wrap(r + offset); }
 
     
     //
@@ -46,7 +53,7 @@ template <class T, isize capacity> struct RingBuffer
     //
 
     isize cap() const { return capacity; }
-    isize count() const { return (capacity + w - r) % capacity; }
+    isize count() const { return wrap(capacity + w - r); }
     double fillLevel() const { return (double)count() / capacity; }
     bool isEmpty() const { return r == w; }
     bool isFull() const { return count() == capacity - 1; }
@@ -58,8 +65,8 @@ template <class T, isize capacity> struct RingBuffer
 
     isize begin() const { return r; }
     isize end() const { return w; }
-    static int next(isize i) { return (capacity + i + 1) % capacity; }
-    static int prev(isize i) { return (capacity + i - 1) % capacity; }
+    static isize next(isize i) { return wrap(capacity + i + 1); }
+    static isize prev(isize i) { return wrap(capacity + i - 1); }
 
 
     //
@@ -78,7 +85,7 @@ template <class T, isize capacity> struct RingBuffer
 
     const T& current(isize offset) const
     {
-        return elements[(r + offset) % capacity];
+        return elements[wrap(r + offset)];
     }
     
     T& read()
@@ -101,7 +108,7 @@ template <class T, isize capacity> struct RingBuffer
     
     void skip(isize n)
     {
-        r = (r + n) % capacity;
+        r = wrap(r + n);
     }
     
     //
@@ -113,6 +120,8 @@ template <class T, isize capacity> struct RingBuffer
 template <class T, isize capacity>
 struct SortedRingBuffer : public RingBuffer<T, capacity>
 {
+    static_assert(RingBuffer<T, capacity>::pow2, "Capacity must be a power of two");
+
     // Key storage
     i64 keys[capacity];
     
@@ -121,25 +130,31 @@ struct SortedRingBuffer : public RingBuffer<T, capacity>
     {
         assert(!this->isFull());
 
-        // Add the new element
-        isize oldw = this->w;
-        this->write(element);
-        keys[oldw] = key;
+        isize pos = this->w;
+        this->w = this->next(this->w);
 
-        // Keep the elements sorted
-        while (oldw != this->r) {
+        // Fast path: Append the element if it doesn't precede the last one
+        if (pos == this->r || key >= keys[this->prev(pos)]) {
+
+            this->elements[pos] = element;
+            keys[pos] = key;
+            return;
+        }
 
-            // Get the index of the preceeding element
-            isize p = this->prev(oldw);
+        // Slow path: Move all elements with a greater key up by one slot
+        do {
 
-            // Exit the loop once we've found the correct position
+            isize p = this->prev(pos);
             if (key >= keys[p]) break;
 
-            // Otherwise, swap elements
-            std::swap(this->elements[oldw], this->elements[p]);
-            std::swap(keys[oldw], keys[p]);
-            oldw = p;
-        }
+            this->elements[pos] = this->elements[p];
+            keys[pos] = keys[p];
+            pos = p;
+
+        } while (pos != this->r);
+
+        this->elements[pos] = element;
+        keys[pos] = key;
     }
 };
 
@@ -0,0 +1,120 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#include "config.h"
+#include "TraceWriter.h"
+#include <assert.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+
+namespace util {
+
+TraceWriter::TraceWriter(isize cap)
+{
+    // Round the capacity up to the next power of two
+    for (capacity = 1; capacity < cap; capacity <<= 1);
+}
+
+TraceWriter::~TraceWriter()
+{
+    close();
+    delete [] buffer;
+}
+
+bool
+TraceWriter::open(const string &path)
+{
+    close();
+
+    file = fopen(path.c_str(), "wb");
+    if (!file) return false;
+
+    if (!buffer) buffer = new u8[capacity];
+
+    head = tail = 0;
+    written = dropped = 0;
+    finished = false;
+    running = true;
+    
+    pthread_create(&thread, nullptr, threadMain, (void *)this);
+    return true;
+}
+
+void
+TraceWriter::close()
+{
+    if (!file) return;
+
+    // Stop the background thread and write out what is left
+    running = false;
+    pthread_join(thread, nullptr);
+    drain();
+
+    fclose(file);
+    file = nullptr;
+}
+
+void
+TraceWriter::write(const void *data, isize len)
+{
+    u64 h = head.load(std::memory_order_relaxed);
+    u64 t = tail.load(std::memory_order_acquire);
+
+    // Never block the producer. Discard the record if it doesn't fit
+    if ((u64)capacity - (h - t) < (u64)len) {
+        dropped += len;
+        return;
+    }
+
+    // Copy the record (it may wrap around the end of the buffer)
+    isize offset = (isize)(h & (capacity - 1));
+    isize chunk = std::min(len, capacity - offset);
+    memcpy(buffer + offset, data, chunk);
+    memcpy(buffer, (const u8 *)data + chunk, len - chunk);
+
+    head.store(h + len, std::memory_order_release);
+    written += len;
+}
+
+void *
+TraceWriter::threadMain(void *writer)
+{
+    TraceWriter *self = (TraceWriter *)writer;
+    assert(self);
+
+    while (self->running) {
+
+        // Check the flag first to catch all records written before finish()
+        bool last = self->finished.load(std::memory_order_acquire);
+
+        self->drain();
+        if (last) { fflush(self->file); break; }
+        usleep(1000);
+    }
+    return nullptr;
+}
+
+void
+TraceWriter::drain()
+{
+    u64 t = tail.load(std::memory_order_relaxed);
+    u64 h = head.load(std::memory_order_acquire);
+
+    while (t < h) {
+
+        isize offset = (isize)(t & (capacity - 1));
+        isize chunk = (isize)std::min(h - t, (u64)(capacity - offset));
+        fwrite(buffer + offset, 1, chunk, file);
+        t += chunk;
+        tail.store(t, std::memory_order_release);
+    }
+}
+
+}
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------
+// This file is part of vAmiga
+//
+// Copyright (C) Dirk W. Hoffmann. www.dirkwhoffmann.de
+// Licensed under the GNU General Public License v3
+//
+// See https://www.gnu.org for license information
+// -----------------------------------------------------------------------------
+
+#pragma once
+
+#include "Types.h"
+#include <atomic>
+#include <pthread.h>
+#include <stdio.h>
+
+namespace util {
+
+/* A TraceWriter streams binary records into a file. Records are written into
+ * a lock-free single-producer single-consumer ring buffer which is drained by
+ * a background thread. The producer never blocks. If the ring buffer is full,
+ * the record is discarded and counted as dropped. Records are either written
+ * as a whole or not at all, which keeps the file parsable.
+ */
+class TraceWriter
+{
+    // The ring buffer (allocated on first use, capacity is a power of two)
+    u8 *buffer = nullptr;
+    isize capacity;
+
+    // Write position (advanced by the producer only)
+    std::atomic<u64> head { 0 };
+
+    // Read position (advanced by the consumer only)
+    std::atomic<u64> tail { 0 };
+
+    // The output file
+    FILE *file = nullptr;
+
+    // The background thread draining the ring buffer
+    pthread_t thread;
+    std::atomic<bool> running { false };
+
+    // Set by the producer when no more records will be written
+    std::atomic<bool> finished { false };
+
+    // Statistics
+    u64 written = 0;
+    u64 dropped = 0;
+
+    
+    //
+    // Initializing
+    //
+
+public:
+
+    TraceWriter(isize capacity = 16 * 1024 * 1024);
+    ~TraceWriter();
+
+    
+    //
+    // Opening and closing the output file
+    //
+
+public:
+
+    // Creates the output file and launches the background thread
+    bool open(const string &path);
+
+    // Flushes all pending records and closes the output file
+    void close();
+
+    /* Signals that no more records will be written (called by the emulator
+     * thread). The background thread writes out all pending records, flushes
+     * the output file, and terminates. The file stays open until close() is
+     * called, but is complete on disk.
+     */
+    void finish() { finished.store(true, std::memory_order_release); }
+
+    bool isOpen() const { return file != nullptr; }
+
+    
+    //
+    // Writing records
+    //
+
+public:
+
+    // Appends a record to the ring buffer (called by the emulator thread)
+    void write(const void *data, isize len);
+    template <class T> void write(const T &record) { write(&record, sizeof(T)); }
+
+    // Returns the number of written or discarded bytes
+    u64 bytesWritten() const { return written; }
+    u64 bytesDropped() const { return dropped; }
+
+    
+    //
+    // Draining the ring buffer
+    //
+
+private:
+
+    static void *threadMain(void *writer);
+
+    // Writes all pending data into the output file
+    void drain();
+};
+
+}
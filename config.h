@@ -16,7 +16,7 @@
 // Snapshot version number
 #define V_MAJOR 0
 #define V_MINOR 9
-#define V_SUBMINOR 18
+#define V_SUBMINOR 19
 
 // Uncomment these settings in a release build
 // #define RELEASEBUILD
@@ -37,8 +37,11 @@ struct FloatStereo; typedef FloatStereo SampleType;
 //
 
 // Uncomment to override a configuration setting
+// A forced Agnus or Denise revision is also applied at compile time and
+// removes all revision checks from the Agnus or Denise code
 
 // #define FORCE_AGNUS_REVISION AGNUS_OCS
+// #define FORCE_DENISE_REVISION DENISE_OCS
 // #define FORCE_BLT_LEVEL      0
 // #define FORCE_CHIP_RAM       512
 // #define FORCE_SLOW_RAM       512
@@ -89,6 +92,7 @@ static const int ECSREG_DEBUG    = 0; // Special ECS register debugging
 static const int INVREG_DEBUG    = 0; // Invalid register accesses
 static const int MEM_DEBUG       = 0; // Memory
 static const int FAS_DEBUG       = 0; // Fast RAM
+static const int MEM_HEATMAP     = 0; // Collect per-frame access heatmaps
 
 // Agnus
 static const int DMA_DEBUG       = 0; // DMA registers
@@ -99,6 +103,7 @@ static const int NO_PTR_DROPS    = 0; // Never drop a pointer register write
 static const int COP_CHECKSUM    = 0; // Compute Copper checksums
 static const int COPREG_DEBUG    = 0; // Copper registers
 static const int COP_DEBUG       = 0; // Copper execution
+static const int COP_PROFILE     = 0; // Collect per-frame Copper statistics
 
 // Blitter
 static const int BLT_CHECKSUM    = 0; // Compute Blitter checksums